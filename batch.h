@@ -0,0 +1,215 @@
+// Пакетная проверка простоты: блок кандидатов за один вызов
+//
+// Возведения в степень для разных кандидатов независимы, поэтому
+// BATCH_LANES цепочек умножений Монтгомери выполняются вперемешку: пока
+// одно умножение ждёт результат, конвейер процессора занят соседними.
+// Результат - битовая карта: бит i установлен, если кандидат i прошёл тест.
+
+#ifndef LABA3_BATCH_H
+#define LABA3_BATCH_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "modarith.h"
+#include "primality.h"
+#include "stats.h"
+
+typedef std::vector<uint64_t> Bitmap;
+
+// Количество одновременно выполняемых цепочек возведения в степень
+const int BATCH_LANES = 8;
+
+// Размер блока кандидатов, который генераторы проверяют за один вызов
+const size_t CANDIDATE_BLOCK = 64;
+
+inline Bitmap makeBitmap(size_t count) {
+    return Bitmap((count + 63) / 64, 0);
+}
+
+inline bool bitmapGet(const Bitmap& bits, size_t i) {
+    return (bits[i / 64] >> (i % 64)) & 1;
+}
+
+inline void bitmapSet(Bitmap& bits, size_t i) {
+    bits[i / 64] |= uint64_t(1) << (i % 64);
+}
+
+// base[l]^exp[l] в форме Монтгомери для LANES независимых модулей.
+// Все дорожки идут по битам показателя синхронно и без ветвлений;
+// у коротких показателей старшие биты нулевые и ничего не меняют.
+template<int LANES>
+void powMontLanes(const Montgomery* mont, const uint64_t* base, const uint64_t* exp, uint64_t* out) {
+    uint64_t a[LANES], e[LANES];
+    uint64_t maxExp = 0;
+    for (int l = 0; l < LANES; ++l) {
+        a[l] = base[l];
+        e[l] = exp[l];
+        out[l] = mont[l].one;
+        maxExp |= exp[l];
+    }
+
+    while (maxExp > 0) {
+        for (int l = 0; l < LANES; ++l) {
+            uint64_t t = mont[l].mul(out[l], a[l]);
+            out[l] = (e[l] & 1) ? t : out[l];
+            a[l] = mont[l].mul(a[l], a[l]);
+            e[l] >>= 1;
+        }
+        maxExp >>= 1;
+    }
+}
+
+// Малые и чётные n, для которых форма Монтгомери неприменима
+// или основание вырождено. Возвращает true, если ответ уже известен.
+inline bool batchTrivial(uint64_t n, bool& prime) {
+    if (n < 5 || n % 2 == 0) {
+        prime = (n == 2 || n == 3);
+        return true;
+    }
+    return false;
+}
+
+// Пакетный тест Ферма по основанию base: base^(n-1) = 1 (mod n), 2 <= base < 5.
+// Любое простое n > base его проходит, поэтому он служит точным
+// предварительным фильтром для всех тестов в программах.
+inline Bitmap batchFermat(const uint64_t* candidates, size_t count, uint64_t base = 2) {
+    Bitmap bits = makeBitmap(count);
+
+    size_t i = 0;
+    while (i < count) {
+        Montgomery mont[BATCH_LANES];
+        uint64_t a[BATCH_LANES], e[BATCH_LANES], x[BATCH_LANES];
+        size_t index[BATCH_LANES];
+        int lanes = 0;
+
+        // Набираем дорожки из нетривиальных кандидатов
+        for (; i < count && lanes < BATCH_LANES; ++i) {
+            uint64_t n = candidates[i];
+            bool prime;
+            if (batchTrivial(n, prime)) {
+                if (prime) bitmapSet(bits, i);
+                continue;
+            }
+            mont[lanes] = Montgomery(n);
+            a[lanes] = mont[lanes].toMont(base);
+            e[lanes] = n - 1;
+            index[lanes] = i;
+            ++lanes;
+        }
+        // Незаполненные дорожки считают фиктивную степень 0
+        for (int l = lanes; l < BATCH_LANES; ++l) {
+            a[l] = mont[l].one;
+            e[l] = 0;
+        }
+
+        powMontLanes<BATCH_LANES>(mont, a, e, x);
+        for (int l = 0; l < lanes; ++l) {
+            if (x[l] == mont[l].one) bitmapSet(bits, index[l]);
+        }
+    }
+    return bits;
+}
+
+// Один сильный раунд по основанию base для кандидатов candidates[idx[k]].
+// Прошедшие остаются в idx, остальные удаляются.
+inline void strongRoundBatch(const uint64_t* candidates, std::vector<size_t>& idx, uint64_t base) {
+    size_t kept = 0;
+    for (size_t k = 0; k < idx.size(); k += BATCH_LANES) {
+        const int lanes = static_cast<int>(std::min<size_t>(BATCH_LANES, idx.size() - k));
+        Montgomery mont[BATCH_LANES];
+        uint64_t a[BATCH_LANES], d[BATCH_LANES], x[BATCH_LANES];
+        int s[BATCH_LANES];
+
+        for (int l = 0; l < BATCH_LANES; ++l) {
+            if (l < lanes) {
+                uint64_t n = candidates[idx[k + l]];
+                mont[l] = Montgomery(n);
+                s[l] = __builtin_ctzll(n - 1);
+                d[l] = (n - 1) >> s[l];
+                a[l] = mont[l].toMont(base);
+            } else {
+                a[l] = mont[l].one; // незаполненные дорожки считают степень 0
+                d[l] = 0;
+            }
+        }
+        powMontLanes<BATCH_LANES>(mont, a, d, x);
+
+        // Досчёт квадратов короткий и выполняется по дорожкам отдельно
+        for (int l = 0; l < lanes; ++l) {
+            const uint64_t minusOne = mont[l].n - mont[l].one;
+            bool passed = x[l] == mont[l].one || x[l] == minusOne || a[l] == 0;
+            for (int j = 0; j < s[l] - 1 && !passed; ++j) {
+                x[l] = mont[l].mul(x[l], x[l]);
+                passed = x[l] == minusOne;
+            }
+            if (passed) idx[kept++] = idx[k + l];
+        }
+    }
+    idx.resize(kept);
+}
+
+// Пакетный детерминированный тест Миллера-Рабина (те же наборы оснований,
+// что и в millerRabinDeterministic). Раунд по основанию 2 отсеивает почти
+// все составные, поэтому следующие основания проверяются только
+// для выживших - тоже по BATCH_LANES дорожек.
+inline Bitmap batchMillerRabin(const uint64_t* candidates, size_t count) {
+    Bitmap bits = makeBitmap(count);
+
+    // Основание 2 общее для всех наборов, остальные - из WITNESS_SETS
+    const WitnessSet& smallSet = WITNESS_SETS[2]; // n < 4759123141
+    const WitnessSet& largeSet = WITNESS_SETS[3];
+
+    std::vector<size_t> idx;
+    idx.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        bool prime;
+        if (batchTrivial(candidates[i], prime)) {
+            if (prime) bitmapSet(bits, i);
+        } else {
+            idx.push_back(i);
+        }
+    }
+
+    strongRoundBatch(candidates, idx, 2);
+
+    std::vector<size_t> small, large;
+    for (size_t i : idx) {
+        (candidates[i] < smallSet.bound ? small : large).push_back(i);
+    }
+    for (int b = 1; b < smallSet.count; ++b) {
+        strongRoundBatch(candidates, small, smallSet.bases[b]);
+    }
+    for (int b = 1; b < largeSet.count; ++b) {
+        strongRoundBatch(candidates, large, largeSet.bases[b]);
+    }
+
+    for (size_t i : small) bitmapSet(bits, i);
+    for (size_t i : large) bitmapSet(bits, i);
+    return bits;
+}
+
+// Пакетная точка входа для любого теста (gostTest, pocklingtonTest,
+// millerTest, millerRabinTest): весь блок сначала проходит чередующийся
+// тест Ферма по основанию 2, а test вызывается только для выживших.
+template<typename Test>
+Bitmap batchTest(const uint64_t* candidates, size_t count, Test test) {
+    Bitmap bits = batchFermat(candidates, count, 2);
+    for (size_t w = 0; w < bits.size(); ++w) {
+        uint64_t word = bits[w];
+        STAT_ADD(STAT_BATCH_FERMAT_REJECTS, std::min<size_t>(64, count - w * 64) - __builtin_popcountll(word));
+        while (word) {
+            int b = __builtin_ctzll(word);
+            word &= word - 1;
+            size_t i = w * 64 + b;
+            if (!test(candidates[i])) {
+                bits[w] &= ~(uint64_t(1) << b);
+            }
+        }
+    }
+    return bits;
+}
+
+#endif // LABA3_BATCH_H
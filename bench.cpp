@@ -0,0 +1,239 @@
+// Бенчмарк тестов простоты и генераторов
+//
+// Для каждого теста (gostTest, pocklingtonTest, millerTest, millerRabinTest)
+// и для mod_pow измеряется время одного вызова на простых и на составных
+// входах размером 16..64 бит, а также число выделений памяти на вызов.
+// Для генераторов - кандидаты и простые в секунду.
+//
+// Запуск:
+//   bench [--json out.json] [--baseline base.json] [--tolerance 0.2] [--min-time 0.2]
+// --json сохраняет результаты, --baseline сравнивает с сохранёнными ранее
+// и завершается с кодом 1, если что-то стало медленнее больше чем на tolerance.
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <new>
+#include <string>
+#include <vector>
+
+#include "gost.h"
+#include "miller.h"
+#include "modarith.h"
+#include "parallel.h"
+#include "pocklington.h"
+#include "primality.h"
+#include "rng.h"
+#include "sieve.h"
+
+using namespace std;
+
+// Подсчёт выделений памяти: глобальный operator new считает вызовы
+static atomic<uint64_t> allocationCount{0};
+
+void* operator new(size_t size) {
+    allocationCount.fetch_add(1, memory_order_relaxed);
+    if (void* p = malloc(size ? size : 1)) return p;
+    throw bad_alloc();
+}
+
+void operator delete(void* p) noexcept {
+    free(p);
+}
+
+void operator delete(void* p, size_t) noexcept {
+    free(p);
+}
+
+// Результат одного замера
+struct BenchResult {
+    string name;
+    double nsPerOp;
+    double allocsPerOp;
+    double itemsPerSecond;
+};
+
+// Случайные нечётные числа ровно bits бит: простые или составные
+vector<uint64_t> makeInputs(int bits, bool prime, size_t count, Xoshiro256& gen) {
+    vector<uint64_t> result;
+    const uint64_t top = uint64_t(1) << (bits - 1);
+    const uint64_t mask = bits == 64 ? ~uint64_t(0) : (uint64_t(1) << bits) - 1;
+    while (result.size() < count) {
+        uint64_t n = ((gen() & mask) | top | 1);
+        if (millerRabinDeterministic(n) == prime) result.push_back(n);
+    }
+    return result;
+}
+
+// Гоняет body по входам, пока не наберётся minTime секунд
+BenchResult measure(const string& name, const vector<uint64_t>& inputs, double minTime,
+                    const function<bool(uint64_t)>& body) {
+    typedef chrono::steady_clock Clock;
+    uint64_t ops = 0;
+    uint64_t sink = 0;
+    const uint64_t allocsBefore = allocationCount.load();
+    const Clock::time_point start = Clock::now();
+    double elapsed = 0;
+
+    do {
+        for (uint64_t n : inputs) {
+            sink += body(n);
+        }
+        ops += inputs.size();
+        elapsed = chrono::duration<double>(Clock::now() - start).count();
+    } while (elapsed < minTime);
+
+    const uint64_t allocs = allocationCount.load() - allocsBefore;
+    if (sink == uint64_t(-1)) cerr << ""; // не даём компилятору выбросить вызовы
+
+    return {name, elapsed * 1e9 / ops, double(allocs) / ops, ops / elapsed};
+}
+
+// Замер генератора: кандидаты в секунду (nsPerOp - время на кандидата).
+// Генератор запускается повторно, пока не наберётся minTime секунд.
+BenchResult measureGenerator(const string& name, double minTime, const function<size_t()>& generate) {
+    typedef chrono::steady_clock Clock;
+    const uint64_t candidatesBefore = generatorCandidates.load();
+    const uint64_t allocsBefore = allocationCount.load();
+    const Clock::time_point start = Clock::now();
+    size_t primesFound = 0;
+    double elapsed = 0;
+
+    do {
+        primesFound += generate();
+        elapsed = chrono::duration<double>(Clock::now() - start).count();
+    } while (elapsed < minTime);
+
+    const uint64_t candidates = generatorCandidates.load() - candidatesBefore;
+    const uint64_t allocs = allocationCount.load() - allocsBefore;
+
+    cout << "  " << name << ": " << primesFound << " простых, "
+         << fixed << setprecision(0) << primesFound / elapsed << " простых/с\n";
+    return {name, elapsed * 1e9 / candidates, double(allocs) / candidates, candidates / elapsed};
+}
+
+void writeJson(const string& path, const vector<BenchResult>& results) {
+    ofstream out(path);
+    out << "{\n  \"benchmarks\": [\n";
+    for (size_t i = 0; i < results.size(); ++i) {
+        const BenchResult& r = results[i];
+        out << "    {\"name\": \"" << r.name << "\", \"ns_per_op\": " << fixed << setprecision(2) << r.nsPerOp
+            << ", \"allocs_per_op\": " << setprecision(3) << r.allocsPerOp
+            << ", \"items_per_second\": " << setprecision(0) << r.itemsPerSecond << "}"
+            << (i + 1 < results.size() ? "," : "") << "\n";
+    }
+    out << "  ]\n}\n";
+}
+
+// Читает файл, записанный writeJson (одна запись на строку)
+map<string, double> readBaseline(const string& path) {
+    map<string, double> result;
+    ifstream in(path);
+    string line;
+    while (getline(in, line)) {
+        size_t name = line.find("\"name\": \"");
+        size_t ns = line.find("\"ns_per_op\": ");
+        if (name == string::npos || ns == string::npos) continue;
+        name += 9;
+        result[line.substr(name, line.find('"', name) - name)] = atof(line.c_str() + ns + 13);
+    }
+    return result;
+}
+
+int main(int argc, char* argv[]) {
+    string jsonPath, baselinePath;
+    double tolerance = 0.20;  // допустимое замедление относительно baseline
+    double minTime = 0.2;     // минимальное время одного замера, с
+
+    for (int i = 1; i < argc; ++i) {
+        string arg = argv[i];
+        if (arg == "--json" && i + 1 < argc) {
+            jsonPath = argv[++i];
+        } else if (arg == "--baseline" && i + 1 < argc) {
+            baselinePath = argv[++i];
+        } else if (arg == "--tolerance" && i + 1 < argc) {
+            tolerance = atof(argv[++i]);
+        } else if (arg == "--min-time" && i + 1 < argc) {
+            minTime = atof(argv[++i]);
+        }
+    }
+
+    setMasterSeed(1);          // одни и те же входы при каждом запуске
+    deterministicMillerRabin = true;
+    Xoshiro256 gen(1, 0);
+
+    struct Kernel {
+        string name;
+        function<bool(uint64_t)> body;
+    };
+    const vector<Kernel> kernels = {
+        {"mod_pow", [](uint64_t n) { return mod_pow(3, n - 1, n) == 1; }},
+        {"millerRabinTest", [](uint64_t n) { return millerRabinTest(n); }},
+        {"gostTest", [](uint64_t n) { return gostTest(n); }},
+        {"pocklingtonTest", [](uint64_t n) { return pocklingtonTest(n); }},
+        {"millerTest", [](uint64_t n) { return millerTest(n); }},
+    };
+    const int sizes[] = {16, 24, 32, 48, 64};
+
+    vector<BenchResult> results;
+    // setw считает байты, а не символы, поэтому заголовок выровнен вручную
+    cout << "тест" << string(30, ' ') << "    нс/вызов  выдел./вызов\n";
+    for (const Kernel& kernel : kernels) {
+        for (int bits : sizes) {
+            for (bool prime : {true, false}) {
+                vector<uint64_t> inputs = makeInputs(bits, prime, 256, gen);
+                string name = kernel.name + "/" + (prime ? "prime" : "composite") + "/" + to_string(bits);
+                BenchResult r = measure(name, inputs, minTime, kernel.body);
+                results.push_back(r);
+                cout << left << setw(34) << name << right << fixed << setprecision(1) << setw(12) << r.nsPerOp
+                     << setprecision(2) << setw(14) << r.allocsPerOp << "\n";
+            }
+        }
+    }
+
+    cout << "\nГенераторы (16 бит, 1 поток):\n";
+    const vector<uint32_t> primes = sievePrimes(500);
+    results.push_back(measureGenerator("generateGostPrimes/16", minTime, [&] {
+        return generateGostPrimes(16, 200, primes, 1).size();
+    }));
+    results.push_back(measureGenerator("generatePocklingtonPrimes/16", minTime, [&] {
+        return generatePocklingtonPrimes(200, primes, 1).size();
+    }));
+    results.push_back(measureGenerator("generateMillerPrimes/16", minTime, [&] {
+        return generateMillerPrimes(200, primes, 1).size();
+    }));
+    for (size_t i = results.size() - 3; i < results.size(); ++i) {
+        cout << "  " << results[i].name << ": " << fixed << setprecision(0) << results[i].itemsPerSecond
+             << " кандидатов/с, " << setprecision(2) << results[i].allocsPerOp << " выдел./кандидат\n";
+    }
+
+    if (!jsonPath.empty()) {
+        writeJson(jsonPath, results);
+        cout << "\nРезультаты сохранены в " << jsonPath << "\n";
+    }
+
+    int regressions = 0;
+    if (!baselinePath.empty()) {
+        map<string, double> baseline = readBaseline(baselinePath);
+        for (const BenchResult& r : results) {
+            auto it = baseline.find(r.name);
+            if (it == baseline.end() || it->second <= 0) continue;
+            double ratio = r.nsPerOp / it->second;
+            if (ratio > 1 + tolerance) {
+                cout << "РЕГРЕССИЯ " << r.name << ": " << fixed << setprecision(2) << it->second
+                     << " -> " << r.nsPerOp << " нс (x" << ratio << ")\n";
+                ++regressions;
+            }
+        }
+        cout << "Сравнение с " << baselinePath << ": регрессий " << regressions << "\n";
+    }
+
+    return regressions > 0 ? 1 : 0;
+}
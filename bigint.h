@@ -0,0 +1,413 @@
+// Целые числа фиксированной длины из LIMBS 64-битных слов
+//
+// Длина - параметр шаблона, поэтому все циклы по словам имеют известное
+// на этапе компиляции число итераций и разворачиваются компилятором.
+// Умножение по модулю - Монтгомери (CIOS), возведение в степень -
+// скользящим окном. Используется генераторами для простых 512-4096 бит
+// без GMP.
+
+#ifndef LABA3_BIGINT_H
+#define LABA3_BIGINT_H
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <type_traits>
+
+#include "modarith.h"
+#include "rng.h"
+#include "sieve.h"
+
+template<int LIMBS>
+struct BigUInt {
+    uint64_t limb[LIMBS]; // младшее слово первым
+
+    BigUInt() : limb() {}
+
+    explicit BigUInt(uint64_t value) : limb() {
+        limb[0] = value;
+    }
+
+    bool isZero() const {
+        uint64_t acc = 0;
+        for (int i = 0; i < LIMBS; ++i) acc |= limb[i];
+        return acc == 0;
+    }
+
+    bool isOdd() const {
+        return limb[0] & 1;
+    }
+
+    bool bit(int i) const {
+        return (limb[i / 64] >> (i % 64)) & 1;
+    }
+
+    void setBit(int i) {
+        limb[i / 64] |= uint64_t(1) << (i % 64);
+    }
+
+    int bitLength() const {
+        for (int i = LIMBS - 1; i >= 0; --i) {
+            if (limb[i]) return i * 64 + 64 - __builtin_clzll(limb[i]);
+        }
+        return 0;
+    }
+
+    // Сравнение: -1, 0, 1
+    static int compare(const BigUInt& a, const BigUInt& b) {
+        for (int i = LIMBS - 1; i >= 0; --i) {
+            if (a.limb[i] != b.limb[i]) return a.limb[i] < b.limb[i] ? -1 : 1;
+        }
+        return 0;
+    }
+
+    friend bool operator==(const BigUInt& a, const BigUInt& b) { return compare(a, b) == 0; }
+    friend bool operator!=(const BigUInt& a, const BigUInt& b) { return compare(a, b) != 0; }
+    friend bool operator<(const BigUInt& a, const BigUInt& b) { return compare(a, b) < 0; }
+    friend bool operator>(const BigUInt& a, const BigUInt& b) { return compare(a, b) > 0; }
+    friend bool operator<=(const BigUInt& a, const BigUInt& b) { return compare(a, b) <= 0; }
+    friend bool operator>=(const BigUInt& a, const BigUInt& b) { return compare(a, b) >= 0; }
+
+    // Арифметика по модулю 2^(64 * LIMBS), чтобы шаблонные тесты
+    // записывались одинаково для встроенных типов и BigUInt
+    friend BigUInt operator+(BigUInt a, const BigUInt& b) { a.add(b); return a; }
+    friend BigUInt operator-(BigUInt a, const BigUInt& b) { a.sub(b); return a; }
+    friend BigUInt operator*(const BigUInt& a, const BigUInt& b) { bool overflow; return mulLow(a, b, overflow); }
+    friend BigUInt operator/(const BigUInt& a, const BigUInt& b) { BigUInt q, r; divMod(a, b, q, r); return q; }
+    friend BigUInt operator%(const BigUInt& a, const BigUInt& b) { BigUInt q, r; divMod(a, b, q, r); return r; }
+    friend BigUInt operator>>(BigUInt a, int k) { a.shiftRight(k); return a; }
+
+    // this += b, возвращает перенос
+    uint64_t add(const BigUInt& b) {
+        uint64_t carry = 0;
+        for (int i = 0; i < LIMBS; ++i) {
+            u128 s = static_cast<u128>(limb[i]) + b.limb[i] + carry;
+            limb[i] = static_cast<uint64_t>(s);
+            carry = static_cast<uint64_t>(s >> 64);
+        }
+        return carry;
+    }
+
+    // this -= b, возвращает заём
+    uint64_t sub(const BigUInt& b) {
+        uint64_t borrow = 0;
+        for (int i = 0; i < LIMBS; ++i) {
+            u128 d = static_cast<u128>(limb[i]) - b.limb[i] - borrow;
+            limb[i] = static_cast<uint64_t>(d);
+            borrow = static_cast<uint64_t>(d >> 64) & 1;
+        }
+        return borrow;
+    }
+
+    // this += v (малое число), возвращает перенос
+    uint64_t addSmall(uint64_t v) {
+        for (int i = 0; i < LIMBS && v; ++i) {
+            limb[i] += v;
+            v = limb[i] < v;
+        }
+        return v;
+    }
+
+    // this -= v (малое число), возвращает заём
+    uint64_t subSmall(uint64_t v) {
+        for (int i = 0; i < LIMBS && v; ++i) {
+            uint64_t old = limb[i];
+            limb[i] -= v;
+            v = old < v;
+        }
+        return v;
+    }
+
+    // this *= m, возвращает старшее слово, не поместившееся в LIMBS
+    uint64_t mulSmall(uint64_t m) {
+        uint64_t carry = 0;
+        for (int i = 0; i < LIMBS; ++i) {
+            u128 p = static_cast<u128>(limb[i]) * m + carry;
+            limb[i] = static_cast<uint64_t>(p);
+            carry = static_cast<uint64_t>(p >> 64);
+        }
+        return carry;
+    }
+
+    // this /= d, возвращает остаток
+    uint64_t divSmall(uint64_t d) {
+        uint64_t rem = 0;
+        for (int i = LIMBS - 1; i >= 0; --i) {
+            u128 cur = (static_cast<u128>(rem) << 64) | limb[i];
+            limb[i] = static_cast<uint64_t>(cur / d);
+            rem = static_cast<uint64_t>(cur % d);
+        }
+        return rem;
+    }
+
+    uint64_t modSmall(uint64_t d) const {
+        uint64_t rem = 0;
+        for (int i = LIMBS - 1; i >= 0; --i) {
+            rem = static_cast<uint64_t>(((static_cast<u128>(rem) << 64) | limb[i]) % d);
+        }
+        return rem;
+    }
+
+    void shiftLeft1() {
+        for (int i = LIMBS - 1; i > 0; --i) {
+            limb[i] = (limb[i] << 1) | (limb[i - 1] >> 63);
+        }
+        limb[0] <<= 1;
+    }
+
+    void shiftRight(int k) {
+        const int words = k / 64, bits = k % 64;
+        for (int i = 0; i < LIMBS; ++i) {
+            uint64_t lo = i + words < LIMBS ? limb[i + words] : 0;
+            uint64_t hi = i + words + 1 < LIMBS ? limb[i + words + 1] : 0;
+            limb[i] = bits ? (lo >> bits) | (hi << (64 - bits)) : lo;
+        }
+    }
+
+    int trailingZeros() const {
+        for (int i = 0; i < LIMBS; ++i) {
+            if (limb[i]) return i * 64 + __builtin_ctzll(limb[i]);
+        }
+        return LIMBS * 64;
+    }
+
+    // Младшие LIMBS слов произведения a * b; overflow - признак переполнения
+    static BigUInt mulLow(const BigUInt& a, const BigUInt& b, bool& overflow) {
+        BigUInt r;
+        overflow = false;
+        for (int i = 0; i < LIMBS; ++i) {
+            if (!a.limb[i]) continue;
+            uint64_t carry = 0;
+            for (int j = 0; j < LIMBS; ++j) {
+                if (i + j >= LIMBS) {
+                    overflow |= (b.limb[j] != 0);
+                    continue;
+                }
+                u128 p = static_cast<u128>(a.limb[i]) * b.limb[j] + r.limb[i + j] + carry;
+                r.limb[i + j] = static_cast<uint64_t>(p);
+                carry = static_cast<uint64_t>(p >> 64);
+            }
+            overflow |= (carry != 0);
+        }
+        return r;
+    }
+
+    // Деление с остатком сдвигами и вычитаниями (для редких вычислений границ)
+    static void divMod(const BigUInt& a, const BigUInt& b, BigUInt& quotient, BigUInt& remainder) {
+        quotient = BigUInt();
+        remainder = BigUInt();
+        for (int i = a.bitLength() - 1; i >= 0; --i) {
+            remainder.shiftLeft1();
+            if (a.bit(i)) remainder.limb[0] |= 1;
+            if (remainder >= b) {
+                remainder.sub(b);
+                quotient.setBit(i);
+            }
+        }
+    }
+
+    std::string toString() const {
+        if (isZero()) return "0";
+        // Делим на 10^19 - наибольшую степень 10, помещающуюся в слово
+        const uint64_t base = 10000000000000000000ULL;
+        BigUInt x = *this;
+        std::string digits;
+        while (!x.isZero()) {
+            uint64_t chunk = x.divSmall(base);
+            for (int i = 0; i < 19; ++i) {
+                digits.push_back(char('0' + chunk % 10));
+                chunk /= 10;
+                if (x.isZero() && chunk == 0) break;
+            }
+        }
+        std::reverse(digits.begin(), digits.end());
+        return digits;
+    }
+};
+
+// Случайное число ровно из bits бит (старший бит установлен)
+template<int LIMBS>
+BigUInt<LIMBS> randomBits(int bits, Xoshiro256& gen) {
+    BigUInt<LIMBS> r;
+    for (int i = 0; i < (bits + 63) / 64; ++i) r.limb[i] = gen();
+    if (bits % 64) r.limb[(bits - 1) / 64] &= (uint64_t(1) << (bits % 64)) - 1;
+    r.setBit(bits - 1);
+    return r;
+}
+
+// Случайное число из [0, limit)
+template<int LIMBS>
+BigUInt<LIMBS> randomBelow(const BigUInt<LIMBS>& limit, Xoshiro256& gen) {
+    const int bits = limit.bitLength();
+    while (true) {
+        BigUInt<LIMBS> r;
+        for (int i = 0; i < (bits + 63) / 64; ++i) r.limb[i] = gen();
+        if (bits % 64) r.limb[(bits - 1) / 64] &= (uint64_t(1) << (bits % 64)) - 1;
+        if (r < limit) return r;
+    }
+}
+
+// НОД двоичным алгоритмом
+template<int LIMBS>
+BigUInt<LIMBS> gcd(BigUInt<LIMBS> a, BigUInt<LIMBS> b) {
+    if (a.isZero()) return b;
+    if (b.isZero()) return a;
+    const int shift = std::min(a.trailingZeros(), b.trailingZeros());
+    a.shiftRight(a.trailingZeros());
+    while (!b.isZero()) {
+        b.shiftRight(b.trailingZeros());
+        if (a > b) std::swap(a, b);
+        b.sub(a);
+    }
+    for (int i = 0; i < shift; ++i) a.shiftLeft1();
+    return a;
+}
+
+// Контекст Монтгомери для нечётного модуля из LIMBS слов, R = 2^(64 * LIMBS)
+template<int LIMBS>
+struct BigMontgomery {
+    typedef BigUInt<LIMBS> Num;
+
+    Num n;
+    uint64_t nInv;  // -n^(-1) mod 2^64
+    Num one;        // R mod n
+    Num r2;         // R^2 mod n
+
+    explicit BigMontgomery(const Num& modulus) : n(modulus) {
+        uint64_t inv = n.limb[0];
+        for (int i = 0; i < 5; ++i) inv *= 2 - n.limb[0] * inv;
+        nInv = 0 - inv;
+
+        // R mod n и R^2 mod n последовательными удвоениями - без деления
+        Num x(1);
+        for (int i = 0; i < 2 * 64 * LIMBS; ++i) {
+            doubleMod(x);
+            if (i == 64 * LIMBS - 1) one = x;
+        }
+        r2 = x;
+    }
+
+    // x = 2x mod n (x < n)
+    void doubleMod(Num& x) const {
+        const uint64_t top = x.limb[LIMBS - 1] >> 63;
+        x.shiftLeft1();
+        if (top || x >= n) x.sub(n);
+    }
+
+    // a * b * R^(-1) mod n (CIOS)
+    Num mul(const Num& a, const Num& b) const {
+        uint64_t t[LIMBS + 2] = {};
+        for (int i = 0; i < LIMBS; ++i) {
+            uint64_t carry = 0;
+            for (int j = 0; j < LIMBS; ++j) {
+                u128 p = static_cast<u128>(a.limb[j]) * b.limb[i] + t[j] + carry;
+                t[j] = static_cast<uint64_t>(p);
+                carry = static_cast<uint64_t>(p >> 64);
+            }
+            u128 s = static_cast<u128>(t[LIMBS]) + carry;
+            t[LIMBS] = static_cast<uint64_t>(s);
+            t[LIMBS + 1] = static_cast<uint64_t>(s >> 64);
+
+            const uint64_t m = t[0] * nInv;
+            u128 p = static_cast<u128>(m) * n.limb[0] + t[0];
+            carry = static_cast<uint64_t>(p >> 64);
+            for (int j = 1; j < LIMBS; ++j) {
+                p = static_cast<u128>(m) * n.limb[j] + t[j] + carry;
+                t[j - 1] = static_cast<uint64_t>(p);
+                carry = static_cast<uint64_t>(p >> 64);
+            }
+            s = static_cast<u128>(t[LIMBS]) + carry;
+            t[LIMBS - 1] = static_cast<uint64_t>(s);
+            t[LIMBS] = t[LIMBS + 1] + static_cast<uint64_t>(s >> 64);
+        }
+
+        Num r;
+        for (int i = 0; i < LIMBS; ++i) r.limb[i] = t[i];
+        if (t[LIMBS] || r >= n) r.sub(n);
+        return r;
+    }
+
+    Num toMont(const Num& a) const {
+        return mul(a, r2);
+    }
+
+    Num fromMont(const Num& a) const {
+        return mul(a, Num(1));
+    }
+
+    // a^e в форме Монтгомери скользящим окном шириной до 5 бит
+    Num powMont(const Num& a, const Num& e) const {
+        const int bits = e.bitLength();
+        if (bits == 0) return one;
+
+        const int window = bits > 256 ? 5 : bits > 32 ? 4 : 1;
+        Num table[16]; // нечётные степени a^1, a^3, ..., a^(2^window - 1)
+        table[0] = a;
+        const Num a2 = mul(a, a);
+        for (int i = 1; i < (1 << (window - 1)); ++i) table[i] = mul(table[i - 1], a2);
+
+        Num result = one;
+        int i = bits - 1;
+        while (i >= 0) {
+            if (!e.bit(i)) {
+                result = mul(result, result);
+                --i;
+                continue;
+            }
+            // Самое длинное окно [j..i], заканчивающееся единичным битом
+            int j = std::max(i - window + 1, 0);
+            while (!e.bit(j)) ++j;
+            int value = 0;
+            for (int k = i; k >= j; --k) {
+                result = mul(result, result);
+                value = (value << 1) | e.bit(k);
+            }
+            result = mul(result, table[value >> 1]);
+            i = j - 1;
+        }
+        return result;
+    }
+
+    Num pow(const Num& a, const Num& e) const {
+        return fromMont(powMont(toMont(a), e));
+    }
+};
+
+template<int LIMBS>
+struct MontgomeryFor<BigUInt<LIMBS>> { typedef BigMontgomery<LIMBS> type; };
+
+template<int LIMBS>
+bool isOdd(const BigUInt<LIMBS>& x) { return x.isOdd(); }
+
+template<int LIMBS>
+int trailingZeros(const BigUInt<LIMBS>& x) { return x.trailingZeros(); }
+
+template<int LIMBS>
+uint32_t smallResidue(const BigUInt<LIMBS>& x, uint32_t p) { return static_cast<uint32_t>(x.modSmall(p)); }
+
+// Есть ли у n делитель среди малых простых (само n малым простым не считается)
+template<int LIMBS>
+bool hasSmallFactor(const BigUInt<LIMBS>& n, uint32_t limit = 2000) {
+    for (uint32_t p : SMALL_PRIMES) {
+        if (p > limit) break;
+        if (n.modSmall(p) == 0) return !(n == BigUInt<LIMBS>(p));
+    }
+    return false;
+}
+
+// Вызывает fn(integral_constant<int, LIMBS>) с наименьшим числом слов,
+// вмещающим bits бит. false, если bits вне диапазона 2..4096.
+template<typename Fn>
+bool withLimbsForBits(int bits, Fn fn) {
+    if (bits < 2 || bits > 4096) return false;
+    if (bits <= 128) fn(std::integral_constant<int, 2>());
+    else if (bits <= 256) fn(std::integral_constant<int, 4>());
+    else if (bits <= 512) fn(std::integral_constant<int, 8>());
+    else if (bits <= 1024) fn(std::integral_constant<int, 16>());
+    else if (bits <= 2048) fn(std::integral_constant<int, 32>());
+    else fn(std::integral_constant<int, 64>());
+    return true;
+}
+
+#endif // LABA3_BIGINT_H
@@ -0,0 +1,300 @@
+// Генерация простых чисел криптографического размера (64-4096 бит)
+//
+// Те же три метода, что и для 16-битных чисел, но на BigUInt<LIMBS>:
+//  - ГОСТ Р 34.10 (процедура A): p = (N + u) * q + 1, q - простое вдвое
+//    меньшей длины, построенное тем же способом рекурсивно, простота
+//    доказывается теоремой Диемитко;
+//  - Поклингтон: n = R * q + 1, q > sqrt(n) - тоже рекурсивно;
+//  - Миллер: n = 2m + 1, m - произведение малых простых, простота
+//    доказывается по известному разложению n - 1 (теорема Люка).
+// Числа до 62 бит строятся напрямую и проверяются детерминированным
+// Миллером-Рабином.
+
+#ifndef LABA3_BIGPRIME_H
+#define LABA3_BIGPRIME_H
+
+#include <algorithm>
+#include <cstdint>
+#include <mutex>
+#include <random>
+#include <set>
+#include <vector>
+
+#include "bigint.h"
+#include "certificate.h"
+#include "parallel.h"
+#include "primality.h"
+#include "rng.h"
+#include "sieve.h"
+
+// Наибольшая длина, для которой простые строятся без рекурсии
+const int BIG_BASE_BITS = 62;
+
+// Решето для кандидатов ГОСТ: простые до BIG_SCREEN_LIMIT, окно из
+// BIG_SCREEN_WINDOW членов прогрессии
+const uint32_t BIG_SCREEN_LIMIT = SMALL_PRIMES_LIMIT;
+const size_t BIG_SCREEN_WINDOW = 256;
+
+// Случайное простое ровно из bits бит (bits <= BIG_BASE_BITS).
+// Генераторы ниже принимают необязательный cert: если он задан, туда
+// записывается сертификат простоты результата (certificate.h).
+template<int LIMBS>
+BigUInt<LIMBS> smallRandomPrime(int bits, Xoshiro256& gen, std::vector<uint8_t>* cert = nullptr) {
+    const uint64_t top = uint64_t(1) << (bits - 1);
+    const uint64_t mask = (uint64_t(1) << bits) - 1;
+    while (true) {
+        uint64_t n = (gen() & mask) | top | 1;
+        generatorCandidates++;
+        if (millerRabinDeterministic(n)) {
+            if (cert) {
+                cert->clear();
+                appendPrimeCertificate(*cert, n);
+            }
+            return BigUInt<LIMBS>(n);
+        }
+    }
+}
+
+// Округление a/b вверх
+template<int LIMBS>
+BigUInt<LIMBS> ceilDiv(const BigUInt<LIMBS>& a, const BigUInt<LIMBS>& b) {
+    BigUInt<LIMBS> quotient, remainder;
+    BigUInt<LIMBS>::divMod(a, b, quotient, remainder);
+    if (!remainder.isZero()) quotient.addSmall(1);
+    return quotient;
+}
+
+// Простое из t бит по процедуре ГОСТ Р 34.10.
+// По теореме Диемитко p = (N + u) * q + 1 простое, если 2^(p-1) = 1 и
+// 2^(N+u) != 1 (mod p): q здесь не меньше 2^(t/2 - 1), поэтому
+// множитель N + u заведомо меньше 4(q + 1).
+template<int LIMBS>
+BigUInt<LIMBS> gostPrimeBig(int t, Xoshiro256& gen, std::vector<uint8_t>* cert = nullptr) {
+    typedef BigUInt<LIMBS> Num;
+    if (t <= BIG_BASE_BITS) return smallRandomPrime<LIMBS>(t, gen, cert);
+
+    std::vector<uint8_t> qCert;
+    const Num q = gostPrimeBig<LIMBS>((t + 1) / 2, gen, cert ? &qCert : nullptr);
+    Num pow2t1;
+    pow2t1.setBit(t - 1); // 2^(t-1)
+
+    ProgressionSieve sieve;
+    std::vector<uint64_t> survivors;
+
+    while (true) {
+        // N = ceil(2^(t-1) / q) + ceil(2^(t-1) * ksi / q), N чётное
+        Num ksi = randomBelow(pow2t1, gen);
+        Num N = ceilDiv(pow2t1, q);
+        N.add(ceilDiv(ksi, q));
+        if (N.isOdd()) N.addSmall(1);
+
+        // p = (N + u) * q + 1 при u = 0, 2, 4, ... - прогрессия с шагом 2q;
+        // до возведения в степень доходят только члены без малых делителей
+        sieve.reset(N * q + Num(1), q + q, BIG_SCREEN_LIMIT);
+        bool exceeded = false;
+        for (Num R = N; !exceeded; R.addSmall(2 * BIG_SCREEN_WINDOW)) {
+            sieve.nextWindow(BIG_SCREEN_WINDOW, survivors);
+            generatorCandidates += BIG_SCREEN_WINDOW;
+
+            for (size_t i = 0; i < BIG_SCREEN_WINDOW; ++i) {
+                if (!((survivors[i / 64] >> (i % 64)) & 1)) continue;
+                Num Ri = R;
+                Ri.addSmall(2 * i);
+                bool overflow;
+                Num p = Num::mulLow(Ri, q, overflow);
+                if (overflow || p.addSmall(1) || p.bitLength() > t) { // вышли за 2^t - новое ksi
+                    exceeded = true;
+                    break;
+                }
+
+                BigMontgomery<LIMBS> mont(p);
+                const Num two(2);
+                if (mont.pow(two, p - Num(1)) != Num(1)) continue;
+                if (mont.pow(two, Ri) == Num(1)) continue;
+                if (cert) {
+                    cert->clear();
+                    appendDiemitkoCertificate(*cert, p, 2, qCert);
+                }
+                return p;
+            }
+        }
+    }
+}
+
+// Простое из bits бит по теореме Поклингтона: n = R * q + 1, где
+// q > sqrt(n) - простое, найденное рекурсивно. n простое, если
+// 2^(n-1) = 1 и НОД(2^R - 1, n) = 1.
+template<int LIMBS>
+BigUInt<LIMBS> pocklingtonPrimeBig(int bits, Xoshiro256& gen, std::vector<uint8_t>* cert = nullptr) {
+    typedef BigUInt<LIMBS> Num;
+    if (bits <= BIG_BASE_BITS) return smallRandomPrime<LIMBS>(bits, gen, cert);
+
+    const int qBits = (bits + 1) / 2 + 1;
+    std::vector<uint8_t> qCert;
+    const Num q = pocklingtonPrimeBig<LIMBS>(qBits, gen, cert ? &qCert : nullptr);
+    const int rBits = bits - q.bitLength() + 1;
+
+    while (true) {
+        // R - случайное чётное, подобранное так, чтобы n имело ровно bits бит
+        Num R = randomBits<LIMBS>(rBits, gen);
+        R.limb[0] &= ~uint64_t(1);
+        bool overflow;
+        Num n = Num::mulLow(R, q, overflow);
+        if (overflow || n.addSmall(1) || n.bitLength() != bits) continue;
+        generatorCandidates++;
+        if (hasSmallFactor(n)) continue;
+
+        BigMontgomery<LIMBS> mont(n);
+        Num nMinus1 = n;
+        nMinus1.subSmall(1);
+        if (mont.pow(Num(2), nMinus1) != Num(1)) continue;
+
+        Num a = mont.pow(Num(2), R);
+        a.subSmall(1);
+        if (gcd(a, n) != Num(1)) continue;
+        if (cert) {
+            cert->clear();
+            appendPocklingtonCertificate(*cert, n, 2, qCert);
+        }
+        return n;
+    }
+}
+
+// Простое из bits бит вида 2m + 1, m - произведение малых простых.
+// Разложение n - 1 известно, и для каждого простого делителя q ищется
+// основание a с a^(n-1) = 1 и a^((n-1)/q) != 1 (теорема Люка).
+template<int LIMBS>
+BigUInt<LIMBS> millerPrimeBig(int bits, Xoshiro256& gen, std::vector<uint8_t>* cert = nullptr) {
+    typedef BigUInt<LIMBS> Num;
+    if (bits <= BIG_BASE_BITS) return smallRandomPrime<LIMBS>(bits, gen, cert);
+
+    // Малые простые, разложенные по длине в битах (2..16)
+    static const std::vector<std::vector<uint32_t>> byLength = [] {
+        std::vector<std::vector<uint32_t>> result(17);
+        for (uint32_t p : smallPrimeTable()) {
+            result[32 - __builtin_clz(p)].push_back(p);
+        }
+        return result;
+    }();
+    static const uint64_t bases[] = {2, 3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37};
+
+    const int mBits = bits - 1;
+    std::vector<uint32_t> factors;
+    std::vector<uint64_t> witnesses; // основание для каждого делителя
+
+    while (true) {
+        // Набираем m множителями по 16 бит, последний - по оставшейся длине.
+        // Если последний множитель дал лишний бит, пробуем другой.
+        Num m(2);
+        factors.assign(1, 2);
+        int misses = 0;
+        while (m.bitLength() < mBits && misses < 16) {
+            const int rest = mBits - m.bitLength() + 1;
+            const std::vector<uint32_t>& bucket = byLength[std::min(rest, 16)];
+            std::uniform_int_distribution<size_t> dis(0, bucket.size() - 1);
+            const uint32_t p = bucket[dis(gen)];
+            Num next = m;
+            next.mulSmall(p);
+            if (next.bitLength() > mBits) {
+                ++misses;
+                continue;
+            }
+            m = next;
+            factors.push_back(p);
+        }
+        if (m.bitLength() != mBits) continue;
+
+        Num n = m;
+        n.shiftLeft1();
+        n.addSmall(1);
+        generatorCandidates++;
+        if (hasSmallFactor(n)) continue;
+
+        BigMontgomery<LIMBS> mont(n);
+        const Num nMinus1 = n - Num(1);
+        const int s = trailingZeros(nMinus1);
+        if (!strongProbablePrime(mont, Num(2), nMinus1 >> s, s)) continue; // сильная проверка по основанию 2
+
+        std::sort(factors.begin(), factors.end());
+        factors.erase(std::unique(factors.begin(), factors.end()), factors.end());
+        const Num one(1);
+
+        // fermat[i]: 0 - не проверено, 1 - bases[i]^(n-1) = 1, -1 - нет
+        int fermat[sizeof(bases) / sizeof(bases[0])] = {};
+        bool proven = true;
+        witnesses.clear();
+        for (uint32_t q : factors) {
+            Num e = nMinus1;
+            e.divSmall(q);
+            bool found = false;
+            for (size_t i = 0; i < sizeof(bases) / sizeof(bases[0]); ++i) {
+                const Num base(bases[i]);
+                if (!fermat[i]) fermat[i] = mont.pow(base, nMinus1) == one ? 1 : -1;
+                if (fermat[i] < 0) break; // n составное
+                if (mont.pow(base, e) != one) {
+                    witnesses.push_back(bases[i]);
+                    found = true;
+                    break;
+                }
+            }
+            if (!found) {
+                proven = false;
+                break;
+            }
+        }
+        if (!proven) continue;
+
+        if (cert) {
+            // Разложение n - 1 полное: узел Поклингтона со всеми делителями
+            cert->clear();
+            cert->push_back(CERT_POCKLINGTON);
+            putNumber(*cert, n);
+            putVarint(*cert, factors.size());
+            for (size_t i = 0; i < factors.size(); ++i) {
+                putVarint(*cert, witnesses[i]);
+                appendPrimeCertificate(*cert, factors[i]);
+            }
+        }
+        return n;
+    }
+}
+
+// Запускает generate(gen, cert) в threads потоках, пока не наберётся count
+// различных чисел. Поток id использует последовательность случайных чисел id.
+// Если certs задан, туда попадают сертификаты в порядке чисел.
+// Как и PrimeCollector, останавливается после COLLECTOR_MISS_LIMIT повторов
+// подряд: у малых длин (--bits 2..8) различных простых бывает меньше count,
+// и тогда возвращается меньше count чисел.
+template<int LIMBS, typename Generate>
+std::vector<BigUInt<LIMBS>> generateBigPrimes(int count, unsigned threads, Generate generate,
+                                              std::vector<std::vector<uint8_t>>* certs = nullptr) {
+    std::mutex mutex;
+    std::vector<BigUInt<LIMBS>> found;
+    std::set<BigUInt<LIMBS>> seen; // повторы при больших count ищутся не перебором
+    uint64_t misses = 0;           // повторов подряд после последнего нового числа
+
+    runWorkers(threads, [&](unsigned id) {
+        Xoshiro256& gen = seedThreadRng(id);
+        std::vector<uint8_t> cert;
+        while (true) {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (found.size() >= static_cast<size_t>(count) || misses >= COLLECTOR_MISS_LIMIT) return;
+            }
+            BigUInt<LIMBS> p = generate(gen, certs ? &cert : nullptr);
+
+            std::lock_guard<std::mutex> lock(mutex);
+            if (found.size() >= static_cast<size_t>(count)) continue;
+            if (!seen.insert(p).second) {
+                ++misses;
+                continue;
+            }
+            misses = 0;
+            found.push_back(p);
+            if (certs) certs->push_back(cert);
+        }
+    });
+    return found;
+}
+
+#endif // LABA3_BIGPRIME_H
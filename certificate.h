@@ -0,0 +1,368 @@
+// Сертификаты простоты: запись при генерации и пакетная проверка
+//
+// Сертификат доказывает простоту n по данным, которые тесты и так
+// вычисляют: простые делители n - 1, основание a, множитель q.
+// Делители доказываются своими сертификатами, рекурсивно до простых
+// из таблицы SMALL_PRIMES.
+//
+// Формат файла: "LCRT", байт версии, затем записи
+//   varint длина | узел
+// Узел:
+//   байт вида | varint длина n в байтах | n (little-endian) | данные вида
+//   CERT_SMALL:       нет данных, n есть в SMALL_PRIMES
+//   CERT_POCKLINGTON: varint k, затем k раз: varint основание a, узел q.
+//                     F - часть n-1 из степеней q; F^2 > n,
+//                     a^(n-1) = 1 и НОД(a^((n-1)/q) - 1, n) = 1 (Поклингтон)
+//   CERT_DIEMITKO:    varint основание a, узел q. n = qR + 1, R чётное,
+//                     R < 4(q + 1), a^(n-1) = 1, a^R != 1 (Диемитко)
+// Длина перед записью позволяет разрезать файл между потоками, не
+// разбирая сертификаты.
+
+#ifndef LABA3_CERTIFICATE_H
+#define LABA3_CERTIFICATE_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "bigint.h"
+#include "encoding.h"
+#include "factor.h"
+#include "mappedfile.h"
+#include "modarith.h"
+#include "parallel.h"
+#include "sieve.h"
+
+const char CERT_MAGIC[4] = {'L', 'C', 'R', 'T'};
+const uint8_t CERT_VERSION = 1;
+
+enum CertKind : uint8_t {
+    CERT_SMALL = 0,
+    CERT_POCKLINGTON = 1,
+    CERT_DIEMITKO = 2,
+};
+
+// Глубже рекурсия бывает только в испорченных файлах
+const int CERT_MAX_DEPTH = 64;
+// Граница перебора оснований при построении сертификата
+const uint64_t CERT_MAX_WITNESS = 1 << 16;
+
+// Число без старших нулевых байтов: длина, затем байты от младшего
+inline void putNumber(std::vector<uint8_t>& out, uint64_t n) {
+    int length = 0;
+    while (length < 8 && (n >> (8 * length))) ++length;
+    putVarint(out, length);
+    for (int i = 0; i < length; ++i) out.push_back(static_cast<uint8_t>(n >> (8 * i)));
+}
+
+template<int LIMBS>
+void putNumber(std::vector<uint8_t>& out, const BigUInt<LIMBS>& n) {
+    const int length = (n.bitLength() + 7) / 8;
+    putVarint(out, length);
+    for (int i = 0; i < length; ++i) out.push_back(static_cast<uint8_t>(n.limb[i / 8] >> (8 * (i % 8))));
+}
+
+// Разбор узлов из памяти с проверкой границ: при выходе за конец
+// или неверных данных failed становится true
+struct CertReader {
+    const uint8_t* pos;
+    const uint8_t* end;
+    bool failed;
+
+    CertReader(const uint8_t* begin, const uint8_t* finish) : pos(begin), end(finish), failed(false) {}
+
+    uint8_t byte() {
+        if (pos >= end) {
+            failed = true;
+            return 0;
+        }
+        return *pos++;
+    }
+
+    uint64_t varint() {
+        return readVarint(pos, end, failed);
+    }
+
+    // Длина числа в байтах (не больше maxBytes)
+    size_t numberLength(size_t maxBytes) {
+        uint64_t length = varint();
+        if (length > maxBytes || length > static_cast<uint64_t>(end - pos)) {
+            failed = true;
+            return 0;
+        }
+        return static_cast<size_t>(length);
+    }
+
+    void number(uint64_t& n) {
+        const size_t length = numberLength(8);
+        n = 0;
+        for (size_t i = 0; i < length; ++i) n |= uint64_t(*pos++) << (8 * i);
+    }
+
+    template<int LIMBS>
+    void number(BigUInt<LIMBS>& n) {
+        const size_t length = numberLength(8 * LIMBS);
+        n = BigUInt<LIMBS>();
+        for (size_t i = 0; i < length; ++i) n.limb[i / 8] |= uint64_t(*pos++) << (8 * (i % 8));
+    }
+};
+
+// ---------- Построение сертификатов ----------
+
+inline bool isTablePrime(uint64_t n) {
+    return n < SMALL_PRIMES_LIMIT && std::binary_search(SMALL_PRIMES.begin(), SMALL_PRIMES.end(), n);
+}
+
+template<int LIMBS>
+bool isTablePrime(const BigUInt<LIMBS>& n) {
+    return n.bitLength() <= 64 && isTablePrime(n.limb[0]);
+}
+
+// Сертификат Поклингтона для 64-битного простого n: n - 1 раскладывается
+// полностью, для каждого q подбирается наименьшее подходящее основание.
+// false, если n не удалось доказать (n составное).
+inline bool appendPrimeCertificate(std::vector<uint8_t>& out, uint64_t n) {
+    if (isTablePrime(n)) {
+        out.push_back(CERT_SMALL);
+        putNumber(out, n);
+        return true;
+    }
+    if (n < SMALL_PRIMES_LIMIT || !isOdd(n)) return false;
+
+    const std::vector<PrimeFactor> factors = factorizeFull(n - 1);
+    out.push_back(CERT_POCKLINGTON);
+    putNumber(out, n);
+    putVarint(out, factors.size());
+
+    Montgomery mont(n);
+    for (const PrimeFactor& f : factors) {
+        // Для простого n подходящее основание находится среди первых
+        uint64_t a = 2;
+        while (a < CERT_MAX_WITNESS && mont.pow(a, (n - 1) / f.p) == 1) ++a;
+        if (a == CERT_MAX_WITNESS || mont.pow(a, n - 1) != 1) return false;
+        putVarint(out, a);
+        if (!appendPrimeCertificate(out, f.p)) return false;
+    }
+    return true;
+}
+
+// Узел Диемитко для n = qR + 1 (сертификат q уже записан в qCert)
+template<typename T>
+void appendDiemitkoCertificate(std::vector<uint8_t>& out, const T& n, uint64_t a, const std::vector<uint8_t>& qCert) {
+    out.push_back(CERT_DIEMITKO);
+    putNumber(out, n);
+    putVarint(out, a);
+    out.insert(out.end(), qCert.begin(), qCert.end());
+}
+
+// Узел Поклингтона с одним множителем q (сертификат q уже записан в qCert)
+template<typename T>
+void appendPocklingtonCertificate(std::vector<uint8_t>& out, const T& n, uint64_t a, const std::vector<uint8_t>& qCert) {
+    out.push_back(CERT_POCKLINGTON);
+    putNumber(out, n);
+    putVarint(out, 1);
+    putVarint(out, a);
+    out.insert(out.end(), qCert.begin(), qCert.end());
+}
+
+// Запись файла сертификатов
+class CertificateWriter {
+public:
+    explicit CertificateWriter(const std::string& path) : out(path, std::ios::binary) {
+        out.write(CERT_MAGIC, sizeof(CERT_MAGIC));
+        out.put(static_cast<char>(CERT_VERSION));
+    }
+
+    bool good() const { return static_cast<bool>(out); }
+
+    void add(const std::vector<uint8_t>& node) {
+        lengthBuffer.clear();
+        putVarint(lengthBuffer, node.size());
+        out.write(reinterpret_cast<const char*>(lengthBuffer.data()), lengthBuffer.size());
+        out.write(reinterpret_cast<const char*>(node.data()), node.size());
+    }
+
+private:
+    std::ofstream out;
+    std::vector<uint8_t> lengthBuffer;
+};
+
+// Сертификаты для списка 64-битных простых; false, если какое-то
+// из чисел не удалось доказать
+template<typename T>
+bool certifyPrimes(const std::vector<T>& primes, std::vector<std::vector<uint8_t>>& nodes) {
+    nodes.assign(primes.size(), std::vector<uint8_t>());
+    for (size_t i = 0; i < primes.size(); ++i) {
+        if (!appendPrimeCertificate(nodes[i], static_cast<uint64_t>(primes[i]))) return false;
+    }
+    return true;
+}
+
+inline bool writeCertificateFile(const std::string& path, const std::vector<std::vector<uint8_t>>& nodes) {
+    CertificateWriter writer(path);
+    for (const std::vector<uint8_t>& node : nodes) writer.add(node);
+    return writer.good();
+}
+
+// ---------- Проверка ----------
+
+template<typename T>
+bool verifyNode(CertReader& r, T& n, int depth);
+
+// Узел делителя: короткие делители длинных чисел проверяются
+// в 64-битной арифметике
+template<typename T>
+bool verifyChild(CertReader& r, T& q, int depth) {
+    if constexpr (!std::is_integral_v<T>) {
+        CertReader peek = r;
+        peek.byte();
+        if (peek.varint() <= 8 && !peek.failed) {
+            uint64_t small;
+            if (!verifyNode(r, small, depth)) return false;
+            q = T(small);
+            return true;
+        }
+    }
+    return verifyNode(r, q, depth);
+}
+
+// Проверяет узел и возвращает доказанное простое в n
+template<typename T>
+bool verifyNode(CertReader& r, T& n, int depth) {
+    if (depth > CERT_MAX_DEPTH) return false;
+    const uint8_t kind = r.byte();
+    r.number(n);
+    if (r.failed) return false;
+
+    if (kind == CERT_SMALL) {
+        return isTablePrime(n);
+    }
+    if (kind != CERT_POCKLINGTON && kind != CERT_DIEMITKO) return false;
+    if (n <= T(2) || !isOdd(n)) return false;
+
+    typename MontgomeryFor<T>::type mont(n);
+    const T one(1);
+    const T nMinus1 = n - one;
+
+    if (kind == CERT_DIEMITKO) {
+        const T a(r.varint());
+        T q;
+        if (r.failed || !verifyChild(r, q, depth + 1)) return false;
+        const T R = nMinus1 / q;
+        if (R * q != nMinus1 || isOdd(R) || (R >> 2) > q) return false; // R < 4(q + 1)
+        return mont.pow(a, nMinus1) == one && mont.pow(a, R) != one;
+    }
+
+    const uint64_t k = r.varint();
+    T F = one;
+    T rest = nMinus1;
+    uint64_t fermatBase = 0; // основание, для которого a^(n-1) = 1 уже проверено
+    for (uint64_t i = 0; i < k && !r.failed; ++i) {
+        const uint64_t base = r.varint();
+        const T a(base);
+        T q;
+        if (r.failed || !verifyChild(r, q, depth + 1)) return false;
+        if (q <= one || rest % q != T(0)) return false;
+        do {
+            rest = rest / q;
+            F = F * q;
+        } while (rest % q == T(0));
+
+        if (base != fermatBase) {
+            if (mont.pow(a, nMinus1) != one) return false;
+            fermatBase = base;
+        }
+        const T x = mont.pow(a, nMinus1 / q);
+        if (x == T(0) || gcd(x - one, n) != one) return false;
+    }
+    return !r.failed && F > n / F; // F^2 > n
+}
+
+// Проверка одной записи: ширина операнда выбирается по длине корня
+inline bool verifyCertificate(const uint8_t* begin, const uint8_t* end) {
+    // Длина корня - сразу за байтом вида
+    CertReader peek(begin, end);
+    peek.byte();
+    const uint64_t rootBytes = peek.varint();
+    if (peek.failed || rootBytes > 512) return false;
+
+    bool ok = false;
+    if (rootBytes <= 8) {
+        CertReader r(begin, end);
+        uint64_t n;
+        ok = verifyNode(r, n, 0) && r.pos == end;
+    } else {
+        withLimbsForBits(static_cast<int>(rootBytes * 8), [&](auto limbs) {
+            constexpr int LIMBS = decltype(limbs)::value;
+            CertReader r(begin, end);
+            BigUInt<LIMBS> n;
+            ok = verifyNode(r, n, 0) && r.pos == end;
+        });
+    }
+    return ok;
+}
+
+// Итог проверки файла
+struct CertificateReport {
+    bool readable;        // файл открылся и начинается с заголовка
+    size_t total;         // записей в файле
+    size_t failed;        // не прошли проверку
+    size_t firstFailed;   // номер первой непрошедшей (total, если таких нет)
+};
+
+// Проверяет все записи файла в threads потоках. Файл отображается
+// в память; первый проход только собирает границы записей.
+inline CertificateReport verifyCertificateFile(const std::string& path, unsigned threads) {
+    CertificateReport report = {false, 0, 0, 0};
+    MappedFile file(path);
+    if (!file.valid() || file.size() < sizeof(CERT_MAGIC) + 1 ||
+        !std::equal(CERT_MAGIC, CERT_MAGIC + sizeof(CERT_MAGIC), file.data()) ||
+        file.data()[sizeof(CERT_MAGIC)] != CERT_VERSION) {
+        return report;
+    }
+    report.readable = true;
+
+    struct Entry {
+        const uint8_t* begin;
+        const uint8_t* end;
+    };
+    std::vector<Entry> entries;
+    CertReader r(file.data() + sizeof(CERT_MAGIC) + 1, file.data() + file.size());
+    bool truncated = false;
+    while (r.pos < r.end) {
+        const uint64_t length = r.varint();
+        if (r.failed || length > static_cast<uint64_t>(r.end - r.pos)) {
+            truncated = true; // обрезанная запись считается непрошедшей
+            break;
+        }
+        entries.push_back({r.pos, r.pos + length});
+        r.pos += length;
+    }
+    report.total = entries.size() + (truncated ? 1 : 0);
+
+    std::atomic<size_t> failed{truncated ? size_t(1) : 0};
+    std::atomic<size_t> firstFailed{truncated ? entries.size() : report.total};
+    const size_t count = entries.size();
+    threads = std::max(1u, std::min<unsigned>(threads, static_cast<unsigned>(std::max<size_t>(count, 1))));
+
+    runWorkers(threads, [&](unsigned id) {
+        const size_t from = count * id / threads;
+        const size_t to = count * (id + 1) / threads;
+        for (size_t i = from; i < to; ++i) {
+            if (verifyCertificate(entries[i].begin, entries[i].end)) continue;
+            failed++;
+            size_t current = firstFailed.load();
+            while (i < current && !firstFailed.compare_exchange_weak(current, i)) {}
+        }
+    });
+
+    report.failed = failed.load();
+    report.firstFailed = firstFailed.load();
+    return report;
+}
+
+#endif // LABA3_CERTIFICATE_H
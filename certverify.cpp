@@ -0,0 +1,57 @@
+// Проверка файла сертификатов простоты
+//
+// Запуск:
+//   certverify FILE [--threads N]
+// Файл отображается в память, записи проверяются в N потоках
+// (0 - все ядра, по умолчанию). Код возврата 1, если хотя бы один
+// сертификат не прошёл проверку или файл не читается.
+
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+#include "certificate.h"
+#include "parallel.h"
+
+using namespace std;
+
+int main(int argc, char* argv[]) {
+    string path;
+    int threads = 0;    // --threads N: число потоков проверки (0 - все ядра)
+
+    for (int i = 1; i < argc; ++i) {
+        string arg = argv[i];
+        if (arg == "--threads" && i + 1 < argc) {
+            threads = atoi(argv[++i]);
+        } else {
+            path = arg;
+        }
+    }
+    if (path.empty()) {
+        cerr << "Использование: certverify FILE [--threads N]\n";
+        return 1;
+    }
+
+    const auto start = chrono::steady_clock::now();
+    CertificateReport report = verifyCertificateFile(path, resolveThreads(threads));
+    const double elapsed = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    if (!report.readable) {
+        cerr << "Не удалось прочитать " << path << " (нет файла или неверный заголовок)\n";
+        return 1;
+    }
+
+    cout << "Сертификатов: " << report.total << ", не прошли: " << report.failed << "\n";
+    if (report.failed > 0) {
+        cout << "Первый непрошедший: №" << report.firstFailed + 1 << "\n";
+    }
+    cout << fixed << setprecision(3) << "Время: " << elapsed << " с";
+    if (elapsed > 0) {
+        cout << setprecision(0) << " (" << report.total / elapsed << " сертификатов/с)";
+    }
+    cout << "\n";
+
+    return report.failed == 0 ? 0 : 1;
+}
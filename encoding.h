@@ -0,0 +1,80 @@
+// Кодирование чисел в двоичных файлах (сертификаты, наборы простых,
+// таблица решета): varint, zigzag, поля little-endian и FNV-1a.
+//
+// varint (LEB128): по 7 бит в байте, старший бит - признак продолжения.
+
+#ifndef LABA3_ENCODING_H
+#define LABA3_ENCODING_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Наибольшая длина 64-битного varint в байтах
+const int VARINT_MAX_BYTES = 10;
+
+// Записывает v в p, возвращает число записанных байтов
+inline int encodeVarint(uint8_t* p, uint64_t v) {
+    int length = 0;
+    while (v >= 0x80) {
+        p[length++] = static_cast<uint8_t>(v) | 0x80;
+        v >>= 7;
+    }
+    p[length++] = static_cast<uint8_t>(v);
+    return length;
+}
+
+inline void putVarint(std::vector<uint8_t>& out, uint64_t v) {
+    while (v >= 0x80) {
+        out.push_back(static_cast<uint8_t>(v) | 0x80);
+        v >>= 7;
+    }
+    out.push_back(static_cast<uint8_t>(v));
+}
+
+// Читает varint из [pos, end) и сдвигает pos. При выходе за end или
+// слишком длинной записи failed становится true, результат 0.
+inline uint64_t readVarint(const uint8_t*& pos, const uint8_t* end, bool& failed) {
+    uint64_t v = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        if (pos >= end) break;
+        const uint8_t b = *pos++;
+        v |= uint64_t(b & 0x7f) << shift;
+        if (!(b & 0x80)) return v;
+    }
+    failed = true;
+    return 0;
+}
+
+// Знаковая разность в беззнаковом виде: 0, -1, 1, -2, ... -> 0, 1, 2, 3, ...
+inline uint64_t zigzagEncode(int64_t v) {
+    return (static_cast<uint64_t>(v) << 1) ^ static_cast<uint64_t>(v >> 63);
+}
+
+inline int64_t zigzagDecode(uint64_t v) {
+    return static_cast<int64_t>(v >> 1) ^ -static_cast<int64_t>(v & 1);
+}
+
+// FNV-1a 64 - контрольная сумма
+const uint64_t FNV_OFFSET = 0xcbf29ce484222325ULL;
+const uint64_t FNV_PRIME = 0x100000001b3ULL;
+
+inline uint64_t fnv1a(uint64_t hash, const uint8_t* data, size_t length) {
+    for (size_t i = 0; i < length; ++i) {
+        hash ^= data[i];
+        hash *= FNV_PRIME;
+    }
+    return hash;
+}
+
+inline void storeLE(uint8_t* p, uint64_t v, int bytes) {
+    for (int i = 0; i < bytes; ++i) p[i] = static_cast<uint8_t>(v >> (8 * i));
+}
+
+inline uint64_t loadLE(const uint8_t* p, int bytes) {
+    uint64_t v = 0;
+    for (int i = 0; i < bytes; ++i) v |= uint64_t(p[i]) << (8 * i);
+    return v;
+}
+
+#endif // LABA3_ENCODING_H
@@ -0,0 +1,194 @@
+// Полное разложение 64-битных чисел на простые множители
+// (и частичное - для BigUInt)
+//
+// 1. Пробное деление на малые простые через обратные элементы по модулю 2^64
+//    (делимость проверяется одним умножением и сравнением, без деления).
+// 2. Ро-метод Полларда в варианте Брента с накоплением произведения
+//    разностей и редкими вызовами gcd.
+// 3. Детерминированный тест Миллера-Рабина для остатков.
+
+#ifndef LABA3_FACTOR_H
+#define LABA3_FACTOR_H
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <numeric>
+#include <vector>
+
+#include "modarith.h"
+#include "primality.h"
+#include "sieve.h"
+
+// Простой множитель и его кратность
+struct PrimeFactor {
+    uint64_t p;
+    int e;
+};
+
+// Малые простые для пробного деления (все нечётные простые до этой границы)
+const uint32_t TRIAL_DIVISION_LIMIT = SMALL_PRIMES_LIMIT;
+
+// Предвычисленный делитель: n делится на p тогда и только тогда,
+// когда n * inv <= limit; в этом случае n * inv - точное частное.
+struct TrialDivisor {
+    uint64_t inv;    // p^(-1) mod 2^64
+    uint64_t limit;  // (2^64 - 1) / p
+    uint32_t p;
+};
+
+constexpr std::array<TrialDivisor, SMALL_PRIMES.size() - 1> makeTrialDivisors() {
+    std::array<TrialDivisor, SMALL_PRIMES.size() - 1> result{};
+    for (size_t i = 1; i < SMALL_PRIMES.size(); ++i) { // без двойки
+        const uint64_t p = SMALL_PRIMES[i];
+        uint64_t inv = p;
+        for (int k = 0; k < 5; ++k) inv *= 2 - p * inv;
+        result[i - 1] = {inv, UINT64_MAX / p, SMALL_PRIMES[i]};
+    }
+    return result;
+}
+
+// Таблица делителей строится при компиляции
+inline constexpr auto TRIAL_DIVISORS = makeTrialDivisors();
+
+// Ро-метод Полларда-Брента: нетривиальный делитель нечётного составного n.
+// f(x) = x^2 + c вычисляется в форме Монтгомери; разности |x - y|
+// перемножаются пачками по BATCH штук, gcd берётся раз на пачку.
+inline uint64_t pollardBrent(uint64_t n) {
+    const int BATCH = 128;
+    Montgomery mont(n);
+
+    for (uint64_t c = 1; ; ++c) {
+        auto f = [&](uint64_t x) {
+            uint64_t y = mont.mul(x, x) + c;
+            return y >= n || y < c ? y - n : y;
+        };
+
+        uint64_t y = 2, x = 2, ys = 2, q = mont.one;
+        uint64_t g = 1;
+        for (uint64_t r = 1; g == 1; r <<= 1) {
+            x = y;
+            for (uint64_t i = 0; i < r; ++i) y = f(y);
+
+            for (uint64_t k = 0; k < r && g == 1; k += BATCH) {
+                ys = y;
+                const uint64_t steps = std::min<uint64_t>(BATCH, r - k);
+                for (uint64_t i = 0; i < steps; ++i) {
+                    y = f(y);
+                    q = mont.mul(q, x > y ? x - y : y - x);
+                }
+                g = std::gcd(q, n);
+            }
+        }
+
+        // Пачка перескочила делитель: повторяем её по одному шагу
+        if (g == n) {
+            do {
+                ys = f(ys);
+                g = std::gcd(x > ys ? x - ys : ys - x, n);
+            } while (g == 1);
+        }
+        if (g != n) return g;
+        // Цикл выродился - пробуем другую константу c
+    }
+}
+
+// Раскладывает n (без малых делителей) и дописывает простые в out
+inline void factorizeLarge(uint64_t n, std::vector<uint64_t>& out) {
+    if (n == 1) return;
+    if (uint64_t(TRIAL_DIVISION_LIMIT) * TRIAL_DIVISION_LIMIT > n || millerRabinDeterministic(n)) {
+        out.push_back(n);
+        return;
+    }
+    uint64_t d = pollardBrent(n);
+    factorizeLarge(d, out);
+    factorizeLarge(n / d, out);
+}
+
+// Полное разложение n > 0: простые множители по возрастанию с кратностями
+inline std::vector<PrimeFactor> factorizeFull(uint64_t n) {
+    std::vector<PrimeFactor> factors;
+    if (n <= 1) return factors;
+
+    int twos = __builtin_ctzll(n);
+    if (twos > 0) {
+        factors.push_back({2, twos});
+        n >>= twos;
+    }
+
+    for (const TrialDivisor& d : TRIAL_DIVISORS) {
+        if (uint64_t(d.p) * d.p > n) break;
+        if (n * d.inv <= d.limit) {
+            int e = 0;
+            do {
+                n *= d.inv;
+                ++e;
+            } while (n * d.inv <= d.limit);
+            factors.push_back({d.p, e});
+        }
+    }
+
+    std::vector<uint64_t> large;
+    factorizeLarge(n, large);
+    std::sort(large.begin(), large.end());
+    for (uint64_t p : large) {
+        if (!factors.empty() && factors.back().p == p) {
+            factors.back().e++;
+        } else {
+            factors.push_back({p, 1});
+        }
+    }
+    return factors;
+}
+
+// Различные простые делители m по возрастанию. unfactored - часть m,
+// которую разложить не удалось (для встроенных типов всегда 1).
+template<typename T>
+std::vector<T> distinctPrimeFactors(const T& m, T& unfactored) {
+    std::vector<T> result;
+    for (const PrimeFactor& f : factorizeFull(m)) {
+        result.push_back(static_cast<T>(f.p));
+    }
+    unfactored = 1;
+    return result;
+}
+
+// Для длинных m - пробное деление на простые до 2^16; остаток считается
+// простым множителем, если проходит тест Миллера-Рабина
+template<int LIMBS>
+std::vector<BigUInt<LIMBS>> distinctPrimeFactors(const BigUInt<LIMBS>& m, BigUInt<LIMBS>& unfactored) {
+    typedef BigUInt<LIMBS> Num;
+    std::vector<Num> result;
+    Num rest = m;
+    for (uint32_t p : smallPrimeTable()) {
+        if (rest.modSmall(p) != 0) continue;
+        result.push_back(Num(p));
+        do {
+            rest.divSmall(p);
+        } while (rest.modSmall(p) == 0);
+    }
+
+    unfactored = Num(1);
+    if (rest != Num(1)) {
+        if (millerRabinTest(rest, 20)) {
+            result.push_back(rest);
+        } else {
+            unfactored = rest;
+        }
+    }
+    return result;
+}
+
+// Наибольший простой делитель m (для длинных m - наибольший из найденных)
+template<typename T>
+T largestPrimeFactor(const T& m) {
+    return static_cast<T>(factorizeFull(m).back().p);
+}
+
+template<int LIMBS>
+BigUInt<LIMBS> largestPrimeFactor(const BigUInt<LIMBS>& m) {
+    BigUInt<LIMBS> unfactored;
+    return distinctPrimeFactors(m, unfactored).back();
+}
+
+#endif // LABA3_FACTOR_H
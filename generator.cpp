@@ -0,0 +1,184 @@
+// Общая часть программ-генераторов (generator.h)
+
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "bigprime.h"
+#include "certificate.h"
+#include "generator.h"
+#include "gost.h"
+#include "miller.h"
+#include "parallel.h"
+#include "pocklington.h"
+#include "primality.h"
+#include "primeio.h"
+#include "rng.h"
+#include "sieve.h"
+
+using namespace std;
+
+const int NUMOFPRIMES = 10;         // Количество простых чисел, которые нужно сгенерировать
+const int SMALL_PRIME_LIMIT = 500;  // Граница простых, из которых выбираются q, F и m
+const int BIG_TEST_ROUNDS = 20;     // Раундов Миллера-Рабина при проверке больших чисел
+const int GOST_SMALL_BITS = 16;     // Длина малых простых ГОСТ
+
+// Таблица для больших чисел: проверка Миллером-Рабином (BIG_TEST_ROUNDS раундов)
+template<int LIMBS>
+void printBigResultsTable(const vector<BigUInt<LIMBS>>& numbers) {
+    cout << "| № | Число | Миллера-Рабина |\n";
+    cout << "------------------------------------\n";
+
+    int rejected = 0;
+
+    for (size_t i = 0; i < numbers.size(); ++i) {
+        bool miller_result = millerRabinTest(numbers[i], BIG_TEST_ROUNDS);
+
+        if (!miller_result) rejected++;
+
+        cout << "| " << i + 1 << " | " << numbers[i].toString() << " | "
+             << (miller_result ? "+" : "-") << " |\n";
+    }
+
+    cout << "k = " << rejected << "\n";
+}
+
+// Одно большое простое из bits бит выбранным алгоритмом
+template<int LIMBS>
+BigUInt<LIMBS> generateBigPrime(GeneratorKind kind, int bits, Xoshiro256& gen, vector<uint8_t>* cert) {
+    switch (kind) {
+    case GeneratorKind::Gost:
+        return gostPrimeBig<LIMBS>(bits, gen, cert);
+    case GeneratorKind::Pocklington:
+        return pocklingtonPrimeBig<LIMBS>(bits, gen, cert);
+    default:
+        return millerPrimeBig<LIMBS>(bits, gen, cert);
+    }
+}
+
+// count малых простых выбранным алгоритмом; sink получает их по мере нахождения
+vector<int> generateSmallPrimes(GeneratorKind kind, int count, const vector<uint32_t>& primes, unsigned threads,
+                                const PrimeSink& sink = nullptr) {
+    switch (kind) {
+    case GeneratorKind::Gost:
+        return generateGostPrimes(GOST_SMALL_BITS, count, primes, threads, sink);
+    case GeneratorKind::Pocklington:
+        return generatePocklingtonPrimes(count, primes, threads, sink);
+    default:
+        return generateMillerPrimes(count, primes, threads, sink);
+    }
+}
+
+// Генерация остановилась на повторах (COLLECTOR_MISS_LIMIT подряд) и
+// различных простых меньше, чем просили: сообщает об этом, true - нехватка
+bool reportShortfall(size_t generated, int count) {
+    if (count <= 0 || generated >= static_cast<size_t>(count)) return false;
+    cerr << "Найдено только " << generated << " различных простых из " << count << ": после "
+         << COLLECTOR_MISS_LIMIT << " повторов подряд новых не нашлось\n";
+    return true;
+}
+
+int runGenerator(GeneratorKind kind, int argc, char* argv[], ResultsTablePrinter printTable) {
+    int count = NUMOFPRIMES;    // --count N: сколько простых сгенерировать
+    int threads = 1;            // --threads N: число потоков генерации (0 - все ядра)
+    int bits = 0;               // --bits B: длина простых (по умолчанию 16 бит на int)
+    string certPath;            // --cert FILE: записать сертификаты простоты
+    OutputFormat format = OutputFormat::Table; // --format table|csv|bin: формат вывода
+    string outPath;             // --out FILE: файл для csv и bin (по умолчанию stdout)
+
+    for (int i = 1; i < argc; ++i) {
+        string arg = argv[i];
+        if (arg == "--deterministic") {
+            deterministicMillerRabin = true; // Миллер-Рабин с фиксированными основаниями
+        } else if (arg == "--count" && i + 1 < argc) {
+            count = atoi(argv[++i]);
+        } else if (arg == "--threads" && i + 1 < argc) {
+            threads = atoi(argv[++i]);
+        } else if (arg == "--bits" && i + 1 < argc) {
+            bits = atoi(argv[++i]); // длина простых, 2..4096 бит
+        } else if (arg == "--cert" && i + 1 < argc) {
+            certPath = argv[++i]; // файл для сертификатов простоты
+        } else if ((arg == "--format" && i + 1 < argc) || arg.rfind("--format=", 0) == 0) {
+            string name = arg == "--format" ? argv[++i] : arg.substr(9);
+            if (!parseOutputFormat(name, format)) {
+                cerr << "--format: допустимые форматы table, csv, bin\n";
+                return 1;
+            }
+        } else if (arg == "--out" && i + 1 < argc) {
+            outPath = argv[++i];
+        } else if (arg == "--seed" && i + 1 < argc) {
+            setMasterSeed(strtoull(argv[++i], nullptr, 10)); // воспроизводимый запуск
+        }
+    }
+
+    if (bits > 0) {
+        if (format == OutputFormat::Bin && bits > 64) {
+            cerr << "--format bin: поддерживаются числа до 64 бит\n";
+            return 1;
+        }
+        // Числа произвольной длины: ширина BigUInt выбирается по bits
+        bool written = true;
+        size_t generated = 0;
+        bool ok = withLimbsForBits(bits, [&](auto limbs) {
+            constexpr int LIMBS = decltype(limbs)::value;
+            vector<vector<uint8_t>> certs;
+            vector<BigUInt<LIMBS>> found = generateBigPrimes<LIMBS>(count, resolveThreads(threads),
+                [&](Xoshiro256& gen, vector<uint8_t>* cert) { return generateBigPrime<LIMBS>(kind, bits, gen, cert); },
+                certPath.empty() ? nullptr : &certs);
+            generated = found.size();
+            if (format == OutputFormat::Table) {
+                printBigResultsTable(found);
+            } else if (!writePrimes(found, format, outPath)) {
+                written = false;
+            }
+            if (!certPath.empty() && writeCertificateFile(certPath, certs)) {
+                (format == OutputFormat::Table ? cout : cerr)
+                    << "Сертификатов записано: " << certs.size() << " (" << certPath << ")\n";
+            }
+        });
+        if (!ok) {
+            cerr << "--bits: допустимая длина 2..4096\n";
+            return 1;
+        }
+        if (!written) {
+            cerr << "Не удалось записать " << (outPath.empty() ? "stdout" : outPath) << "\n";
+            return 1;
+        }
+        return reportShortfall(generated, count) ? 1 : 0;
+    }
+
+    vector<uint32_t> primes = sievePrimes(SMALL_PRIME_LIMIT); // Простые для выбора q, F и m
+
+    vector<int> found;
+    size_t generated = 0;
+    if (format == OutputFormat::Table) {
+        found = generateSmallPrimes(kind, count, primes, resolveThreads(threads));
+        generated = found.size();
+        printTable(found);
+    } else {
+        // csv и bin пишутся по мере нахождения; список нужен только для --cert
+        PrimeWriter writer(format, outPath);
+        generateSmallPrimes(kind, count, primes, resolveThreads(threads), [&](uint64_t p) {
+            writer.add(p);
+            ++generated;
+            if (!certPath.empty()) found.push_back(static_cast<int>(p));
+        });
+        if (!writer.finish()) {
+            cerr << "Не удалось записать " << (outPath.empty() ? "stdout" : outPath) << "\n";
+            return 1;
+        }
+    }
+
+    if (!certPath.empty()) {
+        vector<vector<uint8_t>> certs;
+        if (!certifyPrimes(found, certs) || !writeCertificateFile(certPath, certs)) {
+            cerr << "Не удалось записать сертификаты в " << certPath << "\n";
+            return 1;
+        }
+        (format == OutputFormat::Table ? cout : cerr)
+            << "Сертификатов записано: " << certs.size() << " (" << certPath << ")\n";
+    }
+
+    return reportShortfall(generated, count) ? 1 : 0;
+}
@@ -0,0 +1,31 @@
+// Общая часть программ-генераторов GOST, Poclington и testMillera
+//
+// Разбор командной строки, генерация малых (int) и больших (--bits)
+// простых, вывод таблицей, в csv или двоичном формате и запись
+// сертификатов собраны в библиотеке laba3 (generator.cpp). Программы
+// отличаются только алгоритмом генерации и таблицей проверок для малых
+// простых.
+//
+// Параметры:
+//   --count N            сколько простых сгенерировать (10)
+//   --threads N          число потоков генерации (0 - все ядра)
+//   --bits B             длина простых 2..4096 бит (по умолчанию - малые int)
+//   --cert FILE          записать сертификаты простоты
+//   --format table|csv|bin, --out FILE   формат и файл вывода
+//   --seed S             воспроизводимый запуск
+//   --deterministic      Миллер-Рабин с фиксированными основаниями
+
+#ifndef LABA3_GENERATOR_H
+#define LABA3_GENERATOR_H
+
+#include <vector>
+
+enum class GeneratorKind { Gost, Pocklington, Miller };
+
+// Таблица проверок найденных малых простых
+typedef void (*ResultsTablePrinter)(const std::vector<int>& numbers);
+
+// Тело main() программы-генератора; возвращает код завершения
+int runGenerator(GeneratorKind kind, int argc, char* argv[], ResultsTablePrinter printTable);
+
+#endif // LABA3_GENERATOR_H
@@ -0,0 +1,158 @@
+// Тест ГОСТ: проверка простоты по теореме Диемитко и генерация простых
+// по процедуре ГОСТ Р 34.10 (p = (N + u) * q + 1)
+
+#ifndef LABA3_GOST_H
+#define LABA3_GOST_H
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "batch.h"
+#include "factor.h"
+#include "modarith.h"
+#include "parallel.h"
+#include "primality.h"
+#include "rng.h"
+#include "sieve.h"
+#include "stats.h"
+
+// Округление результата деления a/b вверх
+inline int bigRound(int a, int b) {
+    return (a + b - 1) / b;
+}
+
+// Шаблонная функция для выбора случайного элемента из вектора
+template<typename T>
+T randomChoice(const std::vector<T>& vec, Xoshiro256& gen) {
+    std::uniform_int_distribution<size_t> dis(0, vec.size() - 1);
+    return vec[dis(gen)];
+}
+
+// Тест ГОСТ для операнда типа T (uint32_t, uint64_t или BigUInt)
+template<typename T>
+bool gostTestKernel(const T& n) {
+    if (n <= T(1)) return false;
+    if (n == T(2) || n == T(3)) return true;
+    if (!isOdd(n)) return false;
+
+    // q - наибольший простой делитель n-1 (полное разложение n-1;
+    // у длинных n - наибольший из найденных)
+    const T nMinus1 = n - T(1);
+    const T q = largestPrimeFactor(nMinus1);
+
+    // Проверка по теореме Диемитко (один контекст Монтгомери на обе степени):
+    typename MontgomeryFor<T>::type mont(n);
+    if (mont.pow(T(2), nMinus1) != T(1)) {
+        return false;
+    }
+
+    if (mont.pow(T(2), nMinus1 / q) == T(1)) {
+        return false;
+    }
+
+    return true;
+}
+
+// Тест ГОСТ (проверка простоты числа n)
+template<typename T>
+bool gostTest(const T& n) {
+    return dispatchWidth(n, [](const auto& m) { return gostTestKernel(m); });
+}
+
+// Сколько членов прогрессии p = (N + u) * q + 1 просеивается за раз
+const size_t GOST_SCREEN_WINDOW = 64;
+
+// Генерация простых чисел по тесту ГОСТ.
+// Потоки (threads) независимо строят кандидатов, у каждого своя
+// последовательность случайных чисел по номеру потока.
+// Если задан sink, числа передаются ему по мере нахождения, а
+// возвращаемый список пуст.
+inline std::vector<int> generateGostPrimes(int t, int count, const std::vector<uint32_t>& primes, unsigned threads,
+                                           const PrimeSink& sink = nullptr) {
+    PrimeCollector collector(count, sink);
+
+    const int pow2t1 = 1 << (t - 1); // 2^(t-1)
+    const int pow2t = 1 << t;        // 2^t
+    // Простых до sqrt(2^t) хватает, чтобы решето оставило только простые
+    const uint32_t screenLimit = t >= 32 ? UINT16_MAX : uint32_t(1) << ((t + 1) / 2);
+
+    runWorkers(threads, [&](unsigned id) {
+        Xoshiro256& gen = seedThreadRng(id);
+        std::uniform_real_distribution<double> dist(0.1, 1.0);
+        ProgressionSieve sieve;
+        std::vector<uint64_t> survivors;
+        uint64_t block[GOST_SCREEN_WINDOW];
+        int factorR[GOST_SCREEN_WINDOW]; // N + u для кандидата block[i]
+
+        while (!collector.done()) {
+            int q = randomChoice(primes, gen);
+            while (bitLength(static_cast<uint32_t>(q)) > bigRound(t, 2)) { // выбираем q по размеру
+                q = randomChoice(primes, gen);
+            }
+
+            bool isFound = false;
+
+            while (!isFound && !collector.done()) {
+                double ksi = dist(gen);
+                int NN = bigRound(pow2t1, q) + bigRound(pow2t1 * ksi, q);
+                int N = NN % 2 == 0 ? NN : NN + 1;  // делаем N четным
+                int u = 0;
+
+                // Кандидаты p = (N + u) * q + 1 для u = 0, 2, 4, ... - прогрессия
+                // с шагом 2q (шаг 2 сохраняет p нечётным). Решето отбрасывает
+                // члены с малыми делителями без возведения в степень.
+                sieve.reset(uint64_t(N) * q + 1, uint64_t(2) * q, screenLimit);
+
+                while (!isFound) {
+                    size_t members = 0; // членов прогрессии в окне, не больше 2^t
+                    while (members < GOST_SCREEN_WINDOW &&
+                           (long long)(N + u + 2 * (int)members) * q + 1 <= pow2t) {
+                        ++members;
+                    }
+                    if (members == 0) {
+                        STAT_COUNT(STAT_GOST_KSI_RESTARTS);
+                        break;
+                    }
+                    generatorCandidates += members;
+                    STAT_ADD(STAT_GOST_MEMBERS, members);
+
+                    size_t size = 0;
+                    {
+                        STAT_TIMER(STAT_STAGE_GOST_SIEVE);
+                        sieve.nextWindow(members, survivors);
+                        for (size_t i = 0; i < members; ++i) {
+                            if ((survivors[i / 64] >> (i % 64)) & 1) {
+                                factorR[size] = N + u + 2 * (int)i;
+                                block[size] = (uint64_t)factorR[size] * q + 1;
+                                ++size;
+                            }
+                        }
+                    }
+                    STAT_ADD(STAT_GOST_SIEVED_OUT, members - size);
+
+                    // Первое условие ГОСТ теста (2^(p-1) = 1) - сразу для всех уцелевших,
+                    // второе - только для прошедших, по порядку u
+                    STAT_TIMER(STAT_STAGE_GOST_TEST);
+                    Bitmap fermat = batchFermat(block, size);
+                    for (size_t i = 0; i < size && !isFound; ++i) {
+                        if (!bitmapGet(fermat, i)) {
+                            STAT_COUNT(STAT_GOST_FERMAT_REJECTS);
+                        } else if (mod_pow(2, factorR[i], block[i]) == 1) {
+                            STAT_COUNT(STAT_GOST_DIEMITKO_REJECTS);
+                        } else {
+                            collector.add(block[i]); // повторы отсекает сборщик
+                            isFound = true;
+                        }
+                    }
+                    u += 2 * members;
+                }
+            }
+        }
+    });
+
+    std::vector<uint64_t> found = collector.results();
+    return std::vector<int>(found.begin(), found.end());
+}
+
+#endif // LABA3_GOST_H
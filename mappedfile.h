@@ -0,0 +1,53 @@
+// Файл, отображённый в память только для чтения (POSIX mmap)
+//
+// Читатели больших файлов (сертификаты, списки простых) работают прямо
+// с отображением: без копирования в буфер и без построчного чтения.
+
+#ifndef LABA3_MAPPEDFILE_H
+#define LABA3_MAPPEDFILE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+class MappedFile {
+public:
+    // sequential = false - доступ вразброс (таблицы с поиском по индексу)
+    explicit MappedFile(const std::string& path, bool sequential = true) : bytes(nullptr), length(0) {
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) return;
+        struct stat st;
+        if (::fstat(fd, &st) == 0 && st.st_size > 0) {
+            void* p = ::mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (p != MAP_FAILED) {
+                bytes = static_cast<const uint8_t*>(p);
+                length = static_cast<size_t>(st.st_size);
+                ::madvise(p, length, sequential ? MADV_SEQUENTIAL : MADV_RANDOM);
+            }
+        }
+        ::close(fd);
+    }
+
+    ~MappedFile() {
+        if (bytes) ::munmap(const_cast<uint8_t*>(bytes), length);
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    // false, если файл не открылся или пуст
+    bool valid() const { return bytes != nullptr; }
+    const uint8_t* data() const { return bytes; }
+    size_t size() const { return length; }
+
+private:
+    const uint8_t* bytes;
+    size_t length;
+};
+
+#endif // LABA3_MAPPEDFILE_H
@@ -0,0 +1,134 @@
+// Тест Миллера (по разложению n-1) и генерация простых вида n = 2m + 1
+
+#ifndef LABA3_MILLER_H
+#define LABA3_MILLER_H
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "batch.h"
+#include "factor.h"
+#include "parallel.h"
+#include "primality.h"
+#include "rng.h"
+#include "stats.h"
+
+// Расширенный тест Миллера (с использованием множителей n-1)
+// для операнда типа T (uint32_t, uint64_t или BigUInt)
+template<typename T>
+bool millerTestKernel(const T& n, int t) {
+    if (n <= T(1)) return false;                 // Не простые числа
+    if (n == T(2) || n == T(3)) return true;     // 2 и 3 простые
+    if (!isOdd(n)) return false;                 // Чётные числа — составные
+
+    const T nMinus1 = n - T(1);
+    T unfactored;
+    std::vector<T> factors = distinctPrimeFactors(nMinus1, unfactored); // Разложение n-1 на простые множители
+    if (unfactored != T(1)) return false;        // Без полного разложения тест неприменим
+
+    Xoshiro256& gen = threadRng();                // Генератор текущего потока
+    typename MontgomeryFor<T>::type mont(n);     // Общий контекст для всех оснований
+
+    for (const T& q : factors) {                 // Для каждого множителя q
+        bool all_conditions = false;             // Флаг, проверяющий условие
+        for (int i = 0; i < t; ++i) {            // Проверяем t раз для разных оснований a
+            const T a = randomBase(n, gen);      // Случайное основание a
+            if (mont.pow(a, nMinus1) != T(1)) {  // Проверка теоремы Ферма: a^(n-1) mod n == 1
+                return false;                     // Если не выполняется, n составное
+            }
+            if (mont.pow(a, nMinus1 / q) != T(1)) { // Если a^((n-1)/q) mod n != 1
+                all_conditions = true;            // Условие выполнено, можем перейти дальше
+                break;
+            }
+        }
+        if (!all_conditions) {                    // Если условие не выполнено ни для одного a
+            return false;                          // n составное
+        }
+    }
+    return true;                                  // Если все проверки прошли — вероятно простое
+}
+
+// Расширенный тест Миллера
+template<typename T>
+bool millerTest(const T& n, int t = 5) {
+    return dispatchWidth(n, [t](const auto& m) { return millerTestKernel(m, t); });
+}
+
+// Функция для генерации числа m — произведения случайных простых из primes
+inline int generateM(int k, const std::vector<uint32_t>& primes, Xoshiro256& gen) {
+    std::uniform_int_distribution<size_t> dis(0, primes.size() - 1);
+
+    while (true) {                               // Бесконечный цикл, пока не найдём подходящее m
+        int m = 1;
+        for (int i = 0; i < k; ++i) {            // Умножаем k случайных простых чисел
+            size_t index = dis(gen);
+            m *= primes[index];
+
+            if (m >= 49999) {                    // Если m стал слишком большим, прерываем и ищем заново
+                STAT_COUNT(STAT_GENERATE_M_RESTARTS);
+                m = -1;
+                break;
+            }
+        }
+        if (m != -1) {                           // Если нашли подходящее m
+            return m;                            // Возвращаем его
+        }
+    }
+}
+
+// Функция генерации простых чисел в threads потоках
+// Если задан sink, числа передаются ему по мере нахождения, а
+// возвращаемый список пуст.
+inline std::vector<int> generateMillerPrimes(int count, const std::vector<uint32_t>& primes, unsigned threads,
+                                             const PrimeSink& sink = nullptr) {
+    PrimeCollector collector(count, sink);       // Найденные простые без повторов
+
+    runWorkers(threads, [&](unsigned id) {
+        Xoshiro256& gen = seedThreadRng(id);    // Своя последовательность случайных чисел
+        std::uniform_int_distribution<int> k_dis(1, 3); // Случайное число k от 1 до 3
+
+        while (!collector.done()) {              // Пока не получим нужное количество чисел
+            uint64_t block[CANDIDATE_BLOCK];     // Блок кандидатов для пакетной проверки
+            {
+                STAT_TIMER(STAT_STAGE_MILLER_BUILD);
+                for (size_t i = 0; i < CANDIDATE_BLOCK; ++i) {
+                    int k = k_dis(gen);          // Случайное число k
+                    int m = generateM(k, primes, gen); // Генерируем m — произведение простых
+                    block[i] = 2 * m + 1;        // Формируем кандидата для теста Миллера
+                }
+            }
+            generatorCandidates += CANDIDATE_BLOCK;
+            STAT_ADD(STAT_MILLER_CANDIDATES, CANDIDATE_BLOCK);
+
+            // Кандидат принимается, если прошёл тест Миллера (в диапазоне) или Миллера-Рабина
+            Bitmap passed;
+            {
+                STAT_TIMER(STAT_STAGE_MILLER_TEST);
+                passed = batchTest(block, CANDIDATE_BLOCK, [](uint64_t n) {
+                    if (n > 1 && n < 100000) {
+                        STAT_COUNT(STAT_MILLER_TEST_CALLS);
+                        if (millerTest(n)) return true;
+                        STAT_COUNT(STAT_MILLER_TEST_REJECTS);
+                    }
+                    STAT_COUNT(STAT_MILLER_RABIN_CALLS);
+                    if (millerRabinTest(n)) return true;
+                    STAT_COUNT(STAT_MILLER_RABIN_REJECTS);
+                    return false;
+                });
+            }
+
+            STAT_TIMER(STAT_STAGE_COLLECT);
+            for (size_t i = 0; i < CANDIDATE_BLOCK; ++i) {
+                if (bitmapGet(passed, i)) {
+                    collector.add(block[i]);     // Повторы отсекает сборщик
+                }
+            }
+        }
+    });
+
+    std::vector<uint64_t> found = collector.results();
+    return std::vector<int>(found.begin(), found.end()); // Возвращаем список сгенерированных простых чисел
+}
+
+#endif // LABA3_MILLER_H
@@ -0,0 +1,133 @@
+// Модульная арифметика в форме Монтгомери для 32- и 64-битных модулей
+//
+// Общий движок для GOST.cpp, Poclington.cpp и testMillera.cpp.
+// Промежуточные произведения считаются в типе двойной ширины (uint64_t
+// или unsigned __int128), поэтому умножение корректно для любого
+// нечётного модуля своей ширины и не требует аппаратного деления
+// на каждом шаге возведения в степень.
+
+#ifndef LABA3_MODARITH_H
+#define LABA3_MODARITH_H
+
+#include <cstdint>
+#include <numeric>
+
+typedef unsigned __int128 u128;
+
+// Тип для произведения двух слов: 32-битным словам хватает 64-битного
+// произведения, 64-битным нужно 128-битное
+template<typename T> struct WideOf;
+template<> struct WideOf<uint32_t> { typedef uint64_t type; };
+template<> struct WideOf<uint64_t> { typedef u128 type; };
+
+// Контекст Монтгомери для фиксированного нечётного модуля n, R = 2^BITS.
+// Строится один раз на кандидата и переиспользуется всеми проверками
+// (Ферма, Поклингтон, Диемитко), которые возводят в степень по тому же n.
+// T - uint32_t или uint64_t: для модулей до 2^32 все умножения 32-битные.
+template<typename T>
+struct MontgomeryT {
+    typedef T Num;
+    typedef typename WideOf<T>::type Wide;
+    static const int BITS = 8 * sizeof(T);
+
+    T n;      // модуль (нечётный)
+    T nInv;   // n^(-1) mod R
+    T one;    // R mod n (единица в форме Монтгомери)
+    T r2;     // R^2 mod n (для перевода в форму Монтгомери)
+
+    // Пустой контекст (модуль 1) - заготовка для массивов контекстов
+    MontgomeryT() : n(1), nInv(1), one(0), r2(0) {}
+
+    explicit MontgomeryT(T modulus) : n(modulus) {
+        // Обратный элемент по методу Ньютона: каждая итерация удваивает
+        // число верных младших битов (n*n = 1 mod 8 даёт стартовые 3 бита)
+        nInv = n;
+        for (int i = 0; i < 5; ++i) {
+            nInv *= 2 - n * nInv;
+        }
+        one = (0 - n) % n;
+        r2 = static_cast<T>(static_cast<Wide>(one) * one % n);
+    }
+
+    // Редукция Монтгомери: t * R^(-1) mod n для t < n * R
+    T reduce(Wide t) const {
+        T m = static_cast<T>(t) * nInv;
+        T mnHigh = static_cast<T>((static_cast<Wide>(m) * n) >> BITS);
+        T tHigh = static_cast<T>(t >> BITS);
+        // Младшие BITS бит t и m*n совпадают, поэтому вычитаем только старшие
+        return tHigh >= mnHigh ? tHigh - mnHigh : tHigh - mnHigh + n;
+    }
+
+    T mul(T a, T b) const {
+        return reduce(static_cast<Wide>(a) * b);
+    }
+
+    T toMont(T a) const {
+        return mul(a % n, r2);
+    }
+
+    T fromMont(T a) const {
+        return reduce(a);
+    }
+
+    // a^e в форме Монтгомери (a уже в форме Монтгомери)
+    T powMont(T a, T e) const {
+        T result = one;
+        while (e > 0) {
+            if (e & 1) {
+                result = mul(result, a);
+            }
+            a = mul(a, a);
+            e >>= 1;
+        }
+        return result;
+    }
+
+    // Обычное (a^e) mod n
+    T pow(T a, T e) const {
+        return fromMont(powMont(toMont(a), e));
+    }
+};
+
+typedef MontgomeryT<uint64_t> Montgomery;
+
+// Контекст Монтгомери для операнда типа T (многословные типы добавляют
+// свою специализацию)
+template<typename T> struct MontgomeryFor { typedef MontgomeryT<T> type; };
+
+// Операции над операндом, которые у многословных чисел - методы
+inline bool isOdd(uint32_t x) { return x & 1; }
+inline bool isOdd(uint64_t x) { return x & 1; }
+inline int trailingZeros(uint32_t x) { return __builtin_ctz(x); }
+inline int trailingZeros(uint64_t x) { return __builtin_ctzll(x); }
+inline int bitLength(uint32_t x) { return x == 0 ? 0 : 32 - __builtin_clz(x); }
+inline int bitLength(uint64_t x) { return x == 0 ? 0 : 64 - __builtin_clzll(x); }
+inline uint64_t gcd(uint64_t a, uint64_t b) { return std::gcd(a, b); }
+
+// Умножение по произвольному модулю (используется для чётных модулей)
+inline uint64_t mulmod(uint64_t a, uint64_t b, uint64_t m) {
+    return static_cast<uint64_t>(static_cast<u128>(a) * b % m);
+}
+
+// Быстрое возведение в степень по модулю: (a^b) % m
+// Для нечётного m работает через контекст Монтгомери, для чётного -
+// через 128-битное деление.
+inline uint64_t mod_pow(uint64_t a, uint64_t b, uint64_t m) {
+    if (m == 1) return 0;
+    if (m & 1) {
+        return Montgomery(m).pow(a, b);
+    }
+
+    uint64_t result = 1;
+    a %= m;
+    while (b > 0) {
+        if (b & 1) {
+            result = mulmod(result, a, m);
+        }
+        a = mulmod(a, a, m);
+        b >>= 1;
+    }
+    return result;
+}
+
+#endif // LABA3_MODARITH_H
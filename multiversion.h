@@ -0,0 +1,20 @@
+// Варианты горячих функций под разные процессоры
+//
+// LABA3_MULTIVERSION перед функцией просит GCC/Clang собрать её в
+// нескольких вариантах (Haswell: AVX2, BMI2, POPCNT; Nehalem: POPCNT;
+// базовый x86-64) и выбирать вариант при загрузке программы по
+// возможностям процессора. Включается при сборке с -DLABA3_TARGET_CLONES
+// (CMake задаёт его, если выключен LABA3_NATIVE: с -march=native всё и
+// так собрано под текущий процессор). Подходит для функций с длинными
+// циклами: вызов варианта идёт через указатель и не встраивается.
+
+#ifndef LABA3_MULTIVERSION_H
+#define LABA3_MULTIVERSION_H
+
+#if defined(LABA3_TARGET_CLONES) && defined(__x86_64__) && defined(__GNUC__)
+#define LABA3_MULTIVERSION __attribute__((target_clones("arch=haswell", "arch=nehalem", "default")))
+#else
+#define LABA3_MULTIVERSION
+#endif
+
+#endif // LABA3_MULTIVERSION_H
@@ -0,0 +1,135 @@
+// Многопоточная генерация простых чисел
+//
+// Каждый поток сам строит и проверяет кандидатов, а найденные простые
+// складывает в общий PrimeCollector. Повторы отсекаются множеством,
+// разбитым на шарды со своими мьютексами, поэтому потоки почти не
+// мешают друг другу.
+
+#ifndef LABA3_PARALLEL_H
+#define LABA3_PARALLEL_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+#include "stats.h"
+
+// Сколько кандидатов построили все генераторы (для бенчмарков)
+inline std::atomic<uint64_t> generatorCandidates{0};
+
+// Множество 64-битных чисел, разбитое на SHARDS независимых частей
+class ShardedSet {
+public:
+    static const int SHARDS = 64;
+
+    // true, если значения ещё не было
+    bool insert(uint64_t value) {
+        Shard& shard = shards[shardIndex(value)];
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        return shard.values.insert(value).second;
+    }
+
+private:
+    struct Shard {
+        std::mutex mutex;
+        std::unordered_set<uint64_t> values;
+    };
+
+    static size_t shardIndex(uint64_t value) {
+        // Финальное перемешивание splitmix64, чтобы соседние числа попадали в разные шарды
+        value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        value = (value ^ (value >> 27)) * 0x94d049bb133111ebULL;
+        value ^= value >> 31;
+        return value % SHARDS;
+    }
+
+    Shard shards[SHARDS];
+};
+
+// Получатель найденных простых при потоковом выводе
+typedef std::function<void(uint64_t)> PrimeSink;
+
+// Сколько повторов подряд считается признаком того, что новых простых
+// генератору уже не найти (count больше множества достижимых чисел)
+const uint64_t COLLECTOR_MISS_LIMIT = uint64_t(1) << 18;
+
+// Сборщик результатов: принимает различные простые, пока их не станет count.
+// Если задан sink, принятые числа сразу передаются ему (по одному, под
+// мьютексом) и не хранятся.
+// После COLLECTOR_MISS_LIMIT повторов подряд сбор тоже завершается:
+// генератор, у которого достижимых простых меньше count, не зациклится,
+// а нехватку покажет accepted() < count.
+class PrimeCollector {
+public:
+    explicit PrimeCollector(size_t count, PrimeSink output = nullptr)
+        : target(count), accepted(0), misses(0), finished(count == 0), sink(std::move(output)) {}
+
+    // true, если число принято (новое и место ещё есть)
+    bool add(uint64_t p) {
+        if (done()) return false;
+        if (!seen.insert(p)) {
+            STAT_COUNT(STAT_COLLECTOR_DUPLICATES);
+            if (misses.fetch_add(1, std::memory_order_relaxed) + 1 >= COLLECTOR_MISS_LIMIT) {
+                finished.store(true, std::memory_order_release);
+            }
+            return false;
+        }
+        misses.store(0, std::memory_order_relaxed);
+
+        std::lock_guard<std::mutex> lock(mutex);
+        if (accepted >= target) return false;
+        if (sink) {
+            sink(p);
+        } else {
+            found.push_back(p);
+        }
+        if (++accepted == target) finished.store(true, std::memory_order_release);
+        return true;
+    }
+
+    bool done() const {
+        return finished.load(std::memory_order_acquire);
+    }
+
+    std::vector<uint64_t> results() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return found;
+    }
+
+private:
+    size_t target;
+    size_t accepted;
+    std::atomic<uint64_t> misses; // повторов подряд после последнего нового числа
+    std::atomic<bool> finished;
+    PrimeSink sink;
+    ShardedSet seen;
+    std::mutex mutex;
+    std::vector<uint64_t> found;
+};
+
+// Число потоков по параметру --threads: 0 - все доступные ядра
+inline unsigned resolveThreads(int requested) {
+    if (requested > 0) return requested;
+    return std::max(1u, std::thread::hardware_concurrency());
+}
+
+// Запускает worker(id) в threads потоках (id = 0..threads-1) и ждёт их
+template<typename Worker>
+void runWorkers(unsigned threads, Worker worker) {
+    if (threads <= 1) {
+        worker(0u);
+        return;
+    }
+    std::vector<std::thread> pool;
+    for (unsigned id = 0; id < threads; ++id) {
+        pool.emplace_back(worker, id);
+    }
+    for (std::thread& t : pool) t.join();
+}
+
+#endif // LABA3_PARALLEL_H
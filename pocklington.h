@@ -0,0 +1,171 @@
+// Тест Поклингтона и генерация простых вида n = R * F + 1
+
+#ifndef LABA3_POCKLINGTON_H
+#define LABA3_POCKLINGTON_H
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "batch.h"
+#include "factor.h"
+#include "modarith.h"
+#include "parallel.h"
+#include "primality.h"
+#include "rng.h"
+#include "stats.h"
+
+// Тест Поклингтона для операнда типа T (uint32_t, uint64_t или BigUInt)
+template<typename T>
+bool pocklingtonTestKernel(const T& n) {
+    if (n <= T(1)) return false;
+    if (n == T(2) || n == T(3)) return true;
+    if (!isOdd(n)) return false;
+
+    // Разложение n-1: F - разложенная часть n-1 (произведение q^e)
+    const T nMinus1 = n - T(1);
+    T unfactored;
+    const std::vector<T> factors = distinctPrimeFactors(nMinus1, unfactored);
+    const T F = nMinus1 / unfactored;
+
+    // Если произведение факторов слишком мало (F^2 <= n) — тест неприменим
+    if (F <= n / F) {
+        return false;
+    }
+
+    Xoshiro256& gen = threadRng(); // Генератор текущего потока
+
+    typename MontgomeryFor<T>::type mont(n); // Один контекст на все возведения в степень по n
+
+    for (int i = 0; i < 10; ++i) {
+        const T a = randomBase(n, gen);
+        if (mont.pow(a, nMinus1) != T(1)) {
+            return false; // Условие Ферма не выполнено
+        }
+
+        bool all_conditions = true;
+        for (const T& q : factors) {
+            // Проверка условия Поклингтона для всех делителей q
+            if (mont.pow(a, nMinus1 / q) == T(1)) {
+                all_conditions = false;
+                break;
+            }
+        }
+
+        if (all_conditions) {
+            return true; // Число вероятно простое
+        }
+    }
+
+    return false; // Число составное
+}
+
+// Тест Поклингтона для проверки простоты числа n
+template<typename T>
+bool pocklingtonTest(const T& n) {
+    return dispatchWidth(n, [](const auto& m) { return pocklingtonTestKernel(m); });
+}
+
+// Форма кандидата n = R * F + 1: F - произведение различных малых простых,
+// R пробегает чётные числа rMin, rMin + 2, ..., всего rCount значений,
+// и при каждом из них n имеет ровно заданную длину
+struct PocklingtonShape {
+    uint32_t F;
+    uint32_t rMin;
+    uint32_t rCount;
+};
+
+// Все произведения различных простых из primes длиной от minBits до
+// maxBits бит и для каждого - диапазон чётных R, при которых
+// n = R * F + 1 имеет ровно targetBits бит
+inline std::vector<PocklingtonShape> pocklingtonShapes(const std::vector<uint32_t>& primes, int minBits, int maxBits,
+                                                       int targetBits) {
+    std::vector<uint32_t> products;
+    const uint64_t productLimit = uint64_t(1) << maxBits;
+    // Перебор подмножеств в порядке возрастания простых; произведение
+    // растёт, поэтому ветка обрывается на первом слишком большом множителе
+    auto extend = [&](auto& self, size_t from, uint64_t F) -> void {
+        if (bitLength(F) >= minBits) products.push_back(static_cast<uint32_t>(F));
+        for (size_t i = from; i < primes.size() && F * primes[i] < productLimit; ++i) {
+            self(self, i + 1, F * primes[i]);
+        }
+    };
+    extend(extend, 0, 1);
+    std::sort(products.begin(), products.end());
+
+    const uint64_t nMin = uint64_t(1) << (targetBits - 1); // n из [nMin, 2 * nMin)
+    std::vector<PocklingtonShape> shapes;
+    for (uint32_t F : products) {
+        uint64_t rMin = (nMin - 1 + F - 1) / F;   // R * F + 1 >= nMin
+        const uint64_t rMax = (2 * nMin - 2) / F; // R * F + 1 < 2 * nMin
+        if (rMin % 2) ++rMin;
+        if (rMin == 0) rMin = 2;
+        if (rMin > rMax) continue;
+        shapes.push_back({F, static_cast<uint32_t>(rMin), static_cast<uint32_t>((rMax - rMin) / 2 + 1)});
+    }
+    return shapes;
+}
+
+// Генерация count простых чисел методом Поклингтона с размером 16 бит.
+// F выбирается равновероятно среди допустимых произведений, R - среди
+// чётных значений, дающих 16-битное n, так что каждый построенный
+// кандидат идёт в проверку.
+// Каждый из threads потоков строит и проверяет свои блоки кандидатов
+// со своей последовательностью случайных чисел (по номеру потока).
+// Если задан sink, числа передаются ему по мере нахождения, а
+// возвращаемый список пуст.
+inline std::vector<int> generatePocklingtonPrimes(int count, const std::vector<uint32_t>& primes, unsigned threads,
+                                                  const PrimeSink& sink = nullptr) {
+    PrimeCollector collector(count, sink);
+    const int target_prime_bits = 16;          // Целевой размер простого в битах
+    const int half_bits = target_prime_bits / 2;
+
+    const int F_min_bits = half_bits + 1;      // Минимальный размер произведения факторов
+    const int F_max_bits = half_bits + 2;      // Максимальный размер
+
+    const std::vector<PocklingtonShape> shapes = pocklingtonShapes(primes, F_min_bits, F_max_bits, target_prime_bits);
+    if (shapes.empty()) return std::vector<int>();
+
+    runWorkers(threads, [&](unsigned id) {
+        Xoshiro256& gen = seedThreadRng(id);
+        std::uniform_int_distribution<size_t> shape_dis(0, shapes.size() - 1);
+
+        while (!collector.done()) {
+            // Набираем блок кандидатов n = R * F + 1
+            uint64_t block[CANDIDATE_BLOCK];
+            {
+                STAT_TIMER(STAT_STAGE_POCK_BUILD);
+                for (size_t i = 0; i < CANDIDATE_BLOCK; ++i) {
+                    const PocklingtonShape& shape = shapes[shape_dis(gen)];
+                    std::uniform_int_distribution<uint32_t> r_dis(0, shape.rCount - 1);
+                    const uint64_t R = shape.rMin + 2 * uint64_t(r_dis(gen));
+                    block[i] = R * shape.F + 1;
+                }
+            }
+            generatorCandidates += CANDIDATE_BLOCK;
+            STAT_ADD(STAT_POCK_CANDIDATES, CANDIDATE_BLOCK);
+
+            // Проверяем весь блок за один вызов
+            Bitmap passed;
+            {
+                STAT_TIMER(STAT_STAGE_POCK_TEST);
+                passed = batchTest(block, CANDIDATE_BLOCK, [](uint64_t n) { return pocklingtonTest(n); });
+            }
+
+            STAT_TIMER(STAT_STAGE_COLLECT);
+            for (size_t i = 0; i < CANDIDATE_BLOCK; ++i) {
+                if (bitmapGet(passed, i)) {
+                    collector.add(block[i]); // Добавляем простое число (повторы отсекаются)
+                } else {
+                    STAT_COUNT(STAT_POCK_TEST_REJECTS);
+                }
+            }
+        }
+    });
+
+    std::vector<uint64_t> found = collector.results();
+    return std::vector<int>(found.begin(), found.end());
+}
+
+#endif // LABA3_POCKLINGTON_H
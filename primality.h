@@ -0,0 +1,161 @@
+// Общие тесты простоты для GOST.cpp, Poclington.cpp и testMillera.cpp
+//
+// Тесты - шаблоны по типу операнда: uint32_t (64-битные произведения),
+// uint64_t (128-битные) и BigUInt<LIMBS>. Точка входа dispatchWidth
+// выбирает самый узкий тип, в который помещается значение, так что
+// 16-битные кандидаты проверяются 32-битной арифметикой.
+
+#ifndef LABA3_PRIMALITY_H
+#define LABA3_PRIMALITY_H
+
+#include <cstdint>
+#include <random>
+#include <type_traits>
+
+#include "bigint.h"
+#include "modarith.h"
+#include "rng.h"
+
+// Режим теста Миллера-Рабина: если true, вместо k случайных оснований
+// используются фиксированные наборы свидетелей, точные для всех n < 2^64.
+// Результат тогда доказан и одинаков при каждом запуске. Для чисел
+// длиннее 64 бит наборов нет, и они проверяются случайными основаниями.
+inline bool deterministicMillerRabin = false;
+
+// Набор оснований, для которого нет сильных псевдопростых ниже bound
+struct WitnessSet {
+    uint64_t bound;
+    int count;
+    uint64_t bases[7];
+};
+
+// Минимальные известные наборы по возрастанию границы
+inline constexpr WitnessSet WITNESS_SETS[] = {
+    {2047, 1, {2}},
+    {1373653, 2, {2, 3}},
+    {4759123141ULL, 3, {2, 7, 61}}, // покрывает 2^32
+    {UINT64_MAX, 7, {2, 325, 9375, 28178, 450775, 9780504, 1795265022}},
+};
+
+// Сколько наборов может понадобиться операнду типа T
+template<typename T>
+constexpr int witnessSetCount() {
+    return sizeof(T) <= 4 ? 3 : 4;
+}
+
+// Вызывает fn(n) с самым узким операндом, вмещающим value:
+// uint32_t, uint64_t или исходный BigUInt. Отрицательные числа не простые.
+template<typename T, typename Fn>
+bool dispatchWidth(const T& value, Fn fn) {
+    if constexpr (std::is_integral_v<T>) {
+        if constexpr (std::is_signed_v<T>) {
+            if (value < 0) return false;
+        }
+        const uint64_t n = static_cast<uint64_t>(value);
+        if (n <= UINT32_MAX) return fn(static_cast<uint32_t>(n));
+        return fn(n);
+    } else {
+        const int bits = value.bitLength();
+        if (bits <= 32) return fn(static_cast<uint32_t>(value.limb[0]));
+        if (bits <= 64) return fn(value.limb[0]);
+        return fn(value);
+    }
+}
+
+// Случайное основание из [2, n - 2] (n >= 5)
+template<typename T>
+T randomBase(const T& n, Xoshiro256& gen) {
+    std::uniform_int_distribution<T> dis(2, n - 2);
+    return dis(gen);
+}
+
+template<int LIMBS>
+BigUInt<LIMBS> randomBase(const BigUInt<LIMBS>& n, Xoshiro256& gen) {
+    return randomBelow(n - BigUInt<LIMBS>(3), gen) + BigUInt<LIMBS>(2);
+}
+
+// Один раунд сильной проверки по основанию a (a в обычной форме).
+// n - 1 = d * 2^s, d нечётное.
+template<typename Mont>
+bool strongProbablePrime(const Mont& mont, typename Mont::Num a, typename Mont::Num d, int s) {
+    typedef typename Mont::Num T;
+    const T one = mont.one;
+    const T minusOne = mont.n - mont.one;
+
+    T x = mont.powMont(mont.toMont(a), d);
+    if (x == one || x == minusOne) return true;
+
+    for (int j = 0; j < s - 1; j++) {
+        x = mont.mul(x, x);
+        if (x == minusOne) return true;
+    }
+    return false;
+}
+
+// Детерминированный тест Миллера-Рабина для uint32_t и uint64_t.
+// Набор оснований выбирается по размеру n из WITNESS_SETS.
+template<typename T>
+bool millerRabinDeterministicKernel(T n) {
+    if (n <= 1) return false;
+    if (n == 2 || n == 3) return true;
+    if (n % 2 == 0) return false;
+
+    int set = 0;
+    while (set + 1 < witnessSetCount<T>() && n >= WITNESS_SETS[set].bound) ++set;
+    const WitnessSet& witnesses = WITNESS_SETS[set];
+
+    T d = n - 1;
+    int s = trailingZeros(d);
+    d >>= s;
+
+    MontgomeryT<T> mont(n);
+    for (int i = 0; i < witnesses.count; i++) {
+        T a = static_cast<T>(witnesses.bases[i] % n);
+        if (a == 0) continue; // основание кратно n - раунд ничего не говорит
+        if (!strongProbablePrime(mont, a, d, s)) return false;
+    }
+    return true;
+}
+
+// Детерминированный тест для любых 64-битных n (до 2^32 - в 32 битах)
+inline bool millerRabinDeterministic(uint64_t n) {
+    if (n <= UINT32_MAX) return millerRabinDeterministicKernel(static_cast<uint32_t>(n));
+    return millerRabinDeterministicKernel(n);
+}
+
+// k раундов Миллера-Рабина со случайными основаниями
+template<typename T>
+bool millerRabinKernel(const T& n, int k) {
+    if (n <= T(1)) return false;
+    if (n == T(2) || n == T(3)) return true;
+    if (!isOdd(n)) return false; // Чётные числа >2 составные
+
+    // Представляем n-1 как d * 2^s, где d нечётное
+    T d = n - T(1);
+    const int s = trailingZeros(d);
+    d = d >> s;
+
+    Xoshiro256& gen = threadRng(); // Генератор текущего потока
+
+    typename MontgomeryFor<T>::type mont(n);
+    for (int i = 0; i < k; i++) {
+        if (!strongProbablePrime(mont, randomBase(n, gen), d, s)) {
+            return false; // Если условие не выполняется - число составное
+        }
+    }
+    return true; // Вероятно простое
+}
+
+// Тест Миллера-Рабина - вероятностный тест на простоту числа n
+// (в детерминированном режиме k игнорируется для n < 2^64)
+template<typename T>
+bool millerRabinTest(const T& value, int k = 5) {
+    return dispatchWidth(value, [k](const auto& n) {
+        if constexpr (std::is_integral_v<std::decay_t<decltype(n)>>) {
+            if (deterministicMillerRabin) return millerRabinDeterministicKernel(n);
+        }
+        return millerRabinKernel(n, k);
+    });
+}
+
+#endif // LABA3_PRIMALITY_H
@@ -0,0 +1,239 @@
+// Таблица простых до большой границы с кэшем на диске
+//
+// Решето до 10^8..10^9 строится секунды, поэтому результат сохраняется
+// в файл и при следующих запусках отображается в память готовым.
+// Таблица хранит бит на нечётное число (1 - простое) и индекс: число
+// простых перед каждым блоком из PRIME_TABLE_BLOCK_WORDS слов, так что
+// pi(n) считается одним обращением к индексу и popcount внутри блока.
+//
+// Формат файла (little-endian):
+//   "LPTB" | версия (4 байта) | limit | слов | блоков | pi(limit) |
+//   FNV-1a предыдущих 40 байт заголовка   (все поля по 8 байт)
+//   биты: слов * 8 байт, бит i - число 2i + 1
+//   индекс: блоков * 4 байта
+// Файл принимается, если совпали хеш заголовка, граница и размер;
+// иначе таблица строится заново и файл перезаписывается.
+
+#ifndef LABA3_PRIMECACHE_H
+#define LABA3_PRIMECACHE_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "encoding.h"
+#include "mappedfile.h"
+#include "parallel.h"
+#include "sieve.h"
+
+const char PRIME_TABLE_MAGIC[4] = {'L', 'P', 'T', 'B'};
+const uint32_t PRIME_TABLE_VERSION = 1;
+const size_t PRIME_TABLE_HEADER = 48;
+// Слов в блоке индекса: pi(n) суммирует не больше стольких popcount
+const uint64_t PRIME_TABLE_BLOCK_WORDS = 8;
+// Граница по умолчанию и наибольшая (базовые простые - uint32_t)
+const uint64_t PRIME_TABLE_DEFAULT_LIMIT = 100000000;
+const uint64_t PRIME_TABLE_MAX_LIMIT = uint64_t(1) << 32;
+
+// Граница и файл таблицы primeTable(). Пустой путь - файл в каталоге
+// кэша пользователя, "-" - не использовать файл.
+inline uint64_t primeTableLimit = PRIME_TABLE_DEFAULT_LIMIT;
+inline std::string primeTableCache;
+
+class PrimeTable {
+public:
+    // Таблица до limit (limit <= PRIME_TABLE_MAX_LIMIT): из файла path,
+    // а если его нет или он не подходит - решетом с записью в path
+    static PrimeTable load(uint64_t limit, const std::string& path, unsigned threads = 1) {
+        limit = std::min(limit, PRIME_TABLE_MAX_LIMIT);
+        PrimeTable table(limit);
+        if (!path.empty() && table.map(path)) return table;
+
+        table.build(threads);
+        if (!path.empty()) table.save(path);
+        return table;
+    }
+
+    uint64_t limit() const { return upper; }
+
+    // true, если таблица взята из файла, а не построена
+    bool mapped() const { return file != nullptr; }
+
+    // n <= limit()
+    bool isPrime(uint64_t n) const {
+        if (n < 3) return n == 2;
+        if (n % 2 == 0) return false;
+        const uint64_t i = n / 2;
+        return (bits[i / 64] >> (i % 64)) & 1;
+    }
+
+    // Число простых не больше n (n <= limit())
+    uint64_t countUpTo(uint64_t n) const {
+        if (n < 2) return 0;
+        const uint64_t i = (n - 1) / 2; // бит наибольшего нечётного <= n
+        const uint64_t word = i / 64;
+        uint64_t count = 1 + index[word / PRIME_TABLE_BLOCK_WORDS]; // 1 - простое 2
+        for (uint64_t w = word / PRIME_TABLE_BLOCK_WORDS * PRIME_TABLE_BLOCK_WORDS; w < word; ++w) {
+            count += __builtin_popcountll(bits[w]);
+        }
+        const uint64_t mask = i % 64 == 63 ? ~uint64_t(0) : (uint64_t(1) << (i % 64 + 1)) - 1;
+        return count + __builtin_popcountll(bits[word] & mask);
+    }
+
+    uint64_t primeCount() const { return total; }
+
+    // Наименьшее простое больше n; 0, если его нет до limit()
+    uint64_t nextPrime(uint64_t n) const {
+        if (n < 2) return upper >= 2 ? 2 : 0;
+        const uint64_t i = (n + 1) / 2; // бит первого нечётного > n
+        uint64_t w = i / 64;
+        if (w >= words) return 0;
+        uint64_t word = bits[w] & (~uint64_t(0) << (i % 64));
+        while (!word) {
+            if (++w >= words) return 0;
+            word = bits[w];
+        }
+        const uint64_t p = 2 * (w * 64 + __builtin_ctzll(word)) + 1;
+        return p <= upper ? p : 0;
+    }
+
+    // Наибольшее простое меньше n (n <= limit() + 1); 0, если n <= 2
+    uint64_t prevPrime(uint64_t n) const {
+        if (n <= 3) return n == 3 ? 2 : 0;
+        const uint64_t i = (n - 2) / 2; // бит последнего нечётного < n
+        uint64_t w = i / 64;
+        uint64_t word = bits[w] & (i % 64 == 63 ? ~uint64_t(0) : (uint64_t(1) << (i % 64 + 1)) - 1);
+        while (!word) {
+            if (w == 0) return 2;
+            word = bits[--w];
+        }
+        return 2 * (w * 64 + 63 - __builtin_clzll(word)) + 1;
+    }
+
+private:
+    explicit PrimeTable(uint64_t limit)
+        : upper(limit), words(((limit + 1) / 2 + 63) / 64),
+          blocks((words + PRIME_TABLE_BLOCK_WORDS - 1) / PRIME_TABLE_BLOCK_WORDS),
+          total(0), bits(nullptr), index(nullptr) {}
+
+    void header(uint8_t* out) const {
+        std::memcpy(out, PRIME_TABLE_MAGIC, sizeof(PRIME_TABLE_MAGIC));
+        storeLE(out + 4, PRIME_TABLE_VERSION, 4);
+        storeLE(out + 8, upper, 8);
+        storeLE(out + 16, words, 8);
+        storeLE(out + 24, blocks, 8);
+        storeLE(out + 32, total, 8);
+        storeLE(out + 40, fnv1a(FNV_OFFSET, out, 40), 8);
+    }
+
+    bool map(const std::string& path) {
+        std::unique_ptr<MappedFile> f(new MappedFile(path, false));
+        if (!f->valid() || f->size() != PRIME_TABLE_HEADER + words * 8 + blocks * 4) return false;
+
+        const uint8_t* data = f->data();
+        total = loadLE(data + 32, 8);
+        uint8_t expected[PRIME_TABLE_HEADER];
+        header(expected);
+        if (std::memcmp(data, expected, PRIME_TABLE_HEADER) != 0) return false;
+
+        bits = reinterpret_cast<const uint64_t*>(data + PRIME_TABLE_HEADER);
+        index = reinterpret_cast<const uint32_t*>(data + PRIME_TABLE_HEADER + words * 8);
+        file = std::move(f);
+        return true;
+    }
+
+    // Сегменты решета sieve.h переносятся в таблицу с инверсией битов;
+    // потоки заполняют разные слова и не мешают друг другу
+    void build(unsigned threads) {
+        ownBits.assign(words, 0);
+        ownIndex.assign(blocks, 0);
+
+        const std::vector<uint32_t> basePrimes = simpleSieve(static_cast<uint32_t>(std::sqrt((double)upper)) + 1);
+        const uint64_t segmentWords = SIEVE_SEGMENT_BYTES / 8;
+        const uint64_t segments = (words + segmentWords - 1) / segmentWords;
+        threads = std::max(1u, std::min<unsigned>(threads, static_cast<unsigned>(segments)));
+
+        runWorkers(threads, [&](unsigned id) {
+            std::vector<uint64_t> segment;
+            for (uint64_t s = id; s < segments; s += threads) {
+                sieveSegment(s * SIEVE_SEGMENT_SPAN, basePrimes, segment);
+                const uint64_t first = s * segmentWords;
+                const uint64_t last = std::min(words, first + segmentWords);
+                for (uint64_t w = first; w < last; ++w) ownBits[w] = ~segment[w - first];
+            }
+        });
+
+        // Числа больше limit в последнем слове не простые
+        const uint64_t usedBits = (upper + 1) / 2 - (words - 1) * 64;
+        if (usedBits < 64) ownBits[words - 1] &= (uint64_t(1) << usedBits) - 1;
+
+        uint64_t count = 0;
+        for (uint64_t w = 0; w < words; ++w) {
+            if (w % PRIME_TABLE_BLOCK_WORDS == 0) ownIndex[w / PRIME_TABLE_BLOCK_WORDS] = static_cast<uint32_t>(count);
+            count += __builtin_popcountll(ownBits[w]);
+        }
+        total = count + (upper >= 2); // нечётные простые и 2
+        bits = ownBits.data();
+        index = ownIndex.data();
+    }
+
+    // Запись во временный файл и переименование: другие процессы видят
+    // либо старый файл, либо новый целиком
+    void save(const std::string& path) const {
+        const std::string temporary = path + ".tmp" + std::to_string(::getpid());
+        std::FILE* out = std::fopen(temporary.c_str(), "wb");
+        if (!out) return;
+        uint8_t head[PRIME_TABLE_HEADER];
+        header(head);
+        bool ok = std::fwrite(head, 1, sizeof(head), out) == sizeof(head) &&
+                  std::fwrite(bits, 8, words, out) == words &&
+                  std::fwrite(index, 4, blocks, out) == blocks;
+        ok = std::fclose(out) == 0 && ok;
+        if (!ok || std::rename(temporary.c_str(), path.c_str()) != 0) std::remove(temporary.c_str());
+    }
+
+    uint64_t upper;
+    uint64_t words;
+    uint64_t blocks;
+    uint64_t total;
+    const uint64_t* bits;
+    const uint32_t* index;
+    std::unique_ptr<MappedFile> file;
+    std::vector<uint64_t> ownBits;
+    std::vector<uint32_t> ownIndex;
+};
+
+// Файл кэша по умолчанию: $XDG_CACHE_HOME, ~/.cache или /tmp
+inline std::string defaultPrimeTablePath(uint64_t limit) {
+    std::string dir;
+    if (const char* xdg = std::getenv("XDG_CACHE_HOME")) {
+        dir = xdg;
+    } else if (const char* home = std::getenv("HOME")) {
+        dir = std::string(home) + "/.cache";
+    } else {
+        dir = "/tmp";
+    }
+    ::mkdir(dir.c_str(), 0755); // уже существует - не ошибка
+    return dir + "/laba3-primes-" + std::to_string(limit) + ".bin";
+}
+
+// Общая таблица до primeTableLimit: загружается при первом обращении
+inline const PrimeTable& primeTable() {
+    static const PrimeTable table = PrimeTable::load(
+        primeTableLimit,
+        primeTableCache == "-" ? std::string() :
+            primeTableCache.empty() ? defaultPrimeTablePath(primeTableLimit) : primeTableCache,
+        resolveThreads(0));
+    return table;
+}
+
+#endif // LABA3_PRIMECACHE_H
@@ -0,0 +1,87 @@
+// Подсчёт простых pi(x) для больших x (primecount.h)
+//
+// Запуск:
+//   primecount [--threads N] x ...
+//   primecount [--threads N] --range A B
+// Для каждого x печатается pi(x), плотность pi(x) / x и отношение к
+// x / ln x; с --range - число простых в [A, B] и их плотность.
+// Числа можно писать как 1e13.
+
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "parallel.h"
+#include "primecount.h"
+
+using namespace std;
+
+// Разбор числа: десятичная запись или мантисса с показателем (1e13, 2.5e12)
+bool parseBound(const string& text, uint64_t& value) {
+    char* end = nullptr;
+    if (text.find_first_of("eE.") == string::npos) {
+        value = strtoull(text.c_str(), &end, 10);
+    } else {
+        const long double v = strtold(text.c_str(), &end);
+        if (v < 0 || v >= 18446744073709551616.0L) return false;
+        value = static_cast<uint64_t>(v);
+    }
+    return !text.empty() && *end == '\0';
+}
+
+int main(int argc, char* argv[]) {
+    int threads = 0;        // --threads N: число потоков (0 - все ядра)
+    bool range = false;     // --range A B: простые в отрезке
+    vector<uint64_t> bounds;
+
+    for (int i = 1; i < argc; ++i) {
+        string arg = argv[i];
+        if (arg == "--threads" && i + 1 < argc) {
+            threads = atoi(argv[++i]);
+        } else if (arg == "--range") {
+            range = true;
+        } else {
+            uint64_t value;
+            if (!parseBound(arg, value)) {
+                cerr << "Неверное число: " << arg << "\n";
+                return 1;
+            }
+            bounds.push_back(value);
+        }
+    }
+    if (bounds.empty() || (range && bounds.size() != 2)) {
+        cerr << "Использование: primecount [--threads N] x ... | --range A B\n";
+        return 1;
+    }
+
+    const unsigned workers = resolveThreads(threads);
+    cout << setprecision(6);
+
+    if (range) {
+        const auto start = chrono::steady_clock::now();
+        const uint64_t count = countPrimesRange(bounds[0], bounds[1], workers);
+        const double elapsed = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        const double length = bounds[1] >= bounds[0] ? double(bounds[1] - bounds[0]) + 1 : 0;
+        cout << "pi[" << bounds[0] << ", " << bounds[1] << "] = " << count;
+        if (length > 0) cout << ", плотность " << count / length;
+        cout << " (" << fixed << setprecision(3) << elapsed << " с)\n";
+        return 0;
+    }
+
+    for (uint64_t x : bounds) {
+        const auto start = chrono::steady_clock::now();
+        const uint64_t count = countPrimes(x, workers);
+        const double elapsed = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        cout << "pi(" << x << ") = " << count;
+        if (x >= 3) {
+            cout << ", плотность " << count / double(x)
+                 << ", pi(x) / (x / ln x) = " << count / (x / log(double(x)));
+        }
+        cout << " (" << fixed << setprecision(3) << elapsed << " с)\n" << defaultfloat << setprecision(6);
+    }
+    return 0;
+}
@@ -0,0 +1,151 @@
+// Подсчёт простых pi(x) без решета до x (метод Люси, Lucy_Hedgehog)
+//
+// S(v) - число нечётных чисел в [3, v], не делящихся на простые меньше
+// текущего p, плюс нечётные простые меньше p. Нужны только v = x / n:
+// их не больше 2 sqrt(x), поэтому память - O(sqrt(x)), время - O(x^(3/4)).
+// Шаг по простому p (аналог шага phi(x, a) = phi(x, a-1) - phi(x/p, a-1)
+// в формуле Мейсселя-Лемера):
+//   S(v) -= S(v / p) - S(p - 1)   для всех v >= p^2.
+// Хранятся только нечётные v <= sqrt(x) ("малые") и x / k для нечётных k
+// ("большие"): при нечётном p большие с нечётным k ссылаются только на
+// большие с нечётным k, так что чётные можно не считать вовсе.
+//
+// Обновление одного массива разбивается на полосы так, что внутри полосы
+// каждый элемент читает только ещё не обновлённые значения других полос;
+// полоса делится между потоками на непрерывные куски.
+
+#ifndef LABA3_PRIMECOUNT_H
+#define LABA3_PRIMECOUNT_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include "multiversion.h"
+#include "parallel.h"
+
+// Полосы короче этого считаются в одном потоке: запуск потоков дороже
+const uint64_t PRIME_COUNT_PARALLEL_MIN = 1 << 16;
+// До этой границы x / d через double точно (частное меньше 2^53)
+const uint64_t PRIME_COUNT_DOUBLE_LIMIT = uint64_t(1) << 53;
+
+// Целая часть квадратного корня
+inline uint64_t isqrt(uint64_t n) {
+    uint64_t r = static_cast<uint64_t>(std::sqrt(static_cast<double>(n)));
+    while (r > 0 && (r > UINT32_MAX || r * r > n)) --r;
+    while (r < UINT32_MAX && (r + 1) * (r + 1) <= n) ++r;
+    return r;
+}
+
+// Деление 32-битных чисел на постоянный делитель умножением (Lemire)
+struct FastDivisor32 {
+    explicit FastDivisor32(uint32_t d) : magic(UINT64_MAX / d + 1) {}
+    uint32_t divide(uint32_t n) const {
+        return static_cast<uint32_t>((static_cast<unsigned __int128>(magic) * n) >> 64);
+    }
+    uint64_t magic;
+};
+
+// Выполняет body(from, to) над [first, last): кусками в threads потоках,
+// если диапазон достаточно длинный, иначе целиком в текущем
+template<typename Body>
+void primeCountBand(uint64_t first, uint64_t last, unsigned threads, Body body) {
+    if (first >= last) return;
+    const uint64_t length = last - first;
+    if (threads <= 1 || length < PRIME_COUNT_PARALLEL_MIN) {
+        body(first, last);
+        return;
+    }
+    runWorkers(threads, [&](unsigned id) {
+        body(first + length * id / threads, first + length * (id + 1) / threads);
+    });
+}
+
+// Шаг по простому p для больших large[j], j из [from, to): large[j] =
+// S(x / k), k = 2j + 1; S(x / (kp)) берётся из large при kp <= sqrt(x),
+// иначе из small
+LABA3_MULTIVERSION
+inline void lucyLargeBand(uint64_t x, uint64_t p, uint32_t sp, uint64_t from, uint64_t to,
+                          uint64_t* large, const uint32_t* small) {
+    const uint64_t kDirect = isqrt(x) / p; // k <= kDirect: kp <= sqrt(x)
+    uint64_t j = from;
+    for (; j < to && 2 * j + 1 <= kDirect; ++j) {
+        large[j] -= large[((2 * j + 1) * p - 1) / 2] - sp;
+    }
+    if (x < PRIME_COUNT_DOUBLE_LIMIT) {
+        const double xd = static_cast<double>(x);
+        for (; j < to; ++j) {
+            const uint64_t q = static_cast<uint64_t>(xd / static_cast<double>((2 * j + 1) * p));
+            large[j] -= small[(q - 1) / 2] - sp;
+        }
+    } else {
+        for (; j < to; ++j) {
+            const uint64_t q = x / ((2 * j + 1) * p);
+            large[j] -= small[(q - 1) / 2] - sp;
+        }
+    }
+}
+
+// Шаг по простому p для малых small[i] = S(2i + 1), i из [from, to)
+LABA3_MULTIVERSION
+inline void lucySmallBand(const FastDivisor32& divisor, uint32_t sp, uint64_t from, uint64_t to, uint32_t* small) {
+    for (uint64_t i = from; i < to; ++i) {
+        small[i] -= small[(divisor.divide(static_cast<uint32_t>(2 * i + 1)) - 1) / 2] - sp;
+    }
+}
+
+// pi(x) для любого 64-битного x
+inline uint64_t countPrimes(uint64_t x, unsigned threads = 1) {
+    if (x < 3) return x == 2;
+
+    const uint64_t root = isqrt(x);
+    // small[i] = S(2i + 1), 2i + 1 <= root
+    // large[j] = S(x / (2j + 1)), 2j + 1 <= root
+    const uint64_t smallSize = (root + 1) / 2;
+    const uint64_t largeSize = (root + 1) / 2;
+    std::vector<uint32_t> small(smallSize);
+    std::vector<uint64_t> large(largeSize);
+    for (uint64_t i = 0; i < smallSize; ++i) small[i] = static_cast<uint32_t>(i);
+    for (uint64_t j = 0; j < largeSize; ++j) large[j] = (x / (2 * j + 1) - 1) / 2;
+
+    for (uint64_t p = 3; p <= root; p += 2) {
+        const uint32_t sp = small[p / 2 - 1]; // S(p - 1)
+        if (small[p / 2] == sp) continue;     // p составное
+        const uint64_t pp = p * p;
+
+        // Большие: k нечётное, k <= min(root, x / p^2). large[k] читает
+        // large[kp] при kp <= root, иначе small[x / (kp)]. Полосы
+        // (top/p, top] идут от внутренней к внешней: элемент полосы читает
+        // только элементы внешних полос, которые ещё не обновлены.
+        const uint64_t kLimit = std::min(root, x / pp);
+        std::vector<uint64_t> bounds;      // границы полос по k, по убыванию
+        for (uint64_t top = kLimit; top > 0; top /= p) bounds.push_back(top);
+        for (size_t b = bounds.size(); b-- > 0;) {
+            const uint64_t hi = bounds[b];
+            const uint64_t lo = b + 1 < bounds.size() ? bounds[b + 1] : 0; // полоса (lo, hi]
+            primeCountBand((lo + 1) / 2, (hi + 1) / 2, threads, [&](uint64_t from, uint64_t to) {
+                lucyLargeBand(x, p, sp, from, to, large.data(), small.data());
+            });
+        }
+
+        // Малые: нечётные v из [p^2, root] по убыванию полос (top/p, top]
+        if (pp > root) continue;
+        const FastDivisor32 divisor(static_cast<uint32_t>(p));
+        for (uint64_t hi = root; hi >= pp; hi /= p) {
+            const uint64_t lo = std::max(hi / p, pp - 1); // полоса (lo, hi]
+            primeCountBand((lo + 1) / 2, (hi + 1) / 2, threads, [&](uint64_t from, uint64_t to) {
+                lucySmallBand(divisor, sp, from, to, small.data());
+            });
+        }
+    }
+    return large[0] + 1; // нечётные простые и 2
+}
+
+// Число простых в [low, high]
+inline uint64_t countPrimesRange(uint64_t low, uint64_t high, unsigned threads = 1) {
+    if (low > high) return 0;
+    return countPrimes(high, threads) - (low > 0 ? countPrimes(low - 1, threads) : 0);
+}
+
+#endif // LABA3_PRIMECOUNT_H
@@ -0,0 +1,311 @@
+// Потоковый вывод найденных простых и чтение двоичных наборов
+//
+// Формат вывода выбирается параметром --format:
+//   table - таблица с результатами тестов (как раньше, для отчёта);
+//   csv   - строки "index,prime";
+//   bin   - двоичный файл, который другой процесс открывает через mmap.
+// Вывод копится в буфере PRIME_IO_BUFFER байт и сбрасывается целиком.
+//
+// Двоичный формат (все поля little-endian):
+//   заголовок: "LPRM" | версия (1 байт) | 3 нулевых байта | размер блока (4 байта)
+//   блоки по blockSize чисел: первое число - varint, остальные -
+//             varint(zigzag(разность с предыдущим))
+//   индекс:   смещение каждого блока от начала файла (8 байт)
+//   хвост:    число записей (8 байт) | FNV-1a всех предыдущих байтов (8 байт)
+// Индекс даёт доступ по номеру: декодируется только один блок.
+
+#ifndef LABA3_PRIMEIO_H
+#define LABA3_PRIMEIO_H
+
+#include <algorithm>
+#include <charconv>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "bigint.h"
+#include "encoding.h"
+#include "mappedfile.h"
+
+const char PRIME_FILE_MAGIC[4] = {'L', 'P', 'R', 'M'};
+const uint8_t PRIME_FILE_VERSION = 1;
+const size_t PRIME_FILE_HEADER = 12;
+const size_t PRIME_FILE_TRAILER = 16;
+// Чисел в блоке: доступ по номеру декодирует не больше стольких varint
+const uint32_t PRIME_FILE_BLOCK = 256;
+// Размер буфера вывода
+const size_t PRIME_IO_BUFFER = 1 << 20;
+
+enum class OutputFormat { Table, Csv, Bin };
+
+// Разбор значения --format; false, если формат неизвестен
+inline bool parseOutputFormat(const std::string& name, OutputFormat& format) {
+    if (name == "table") format = OutputFormat::Table;
+    else if (name == "csv") format = OutputFormat::Csv;
+    else if (name == "bin") format = OutputFormat::Bin;
+    else return false;
+    return true;
+}
+
+// Буферизованный вывод в файл или stdout (путь "" или "-").
+// Считает записанные байты и их FNV-1a.
+class BufferedOutput {
+public:
+    explicit BufferedOutput(const std::string& path)
+        : file(path.empty() || path == "-" ? stdout : std::fopen(path.c_str(), "wb")),
+          owned(file && file != stdout), failed(file == nullptr),
+          buffer(PRIME_IO_BUFFER), used(0), total(0), hash(FNV_OFFSET) {}
+
+    ~BufferedOutput() { close(); }
+
+    BufferedOutput(const BufferedOutput&) = delete;
+    BufferedOutput& operator=(const BufferedOutput&) = delete;
+
+    bool good() const { return !failed; }
+
+    // Байтов записано с начала (включая ещё не сброшенные)
+    uint64_t offset() const { return total + used; }
+
+    // Место под n байтов (n <= PRIME_IO_BUFFER); после записи - commit(n)
+    uint8_t* reserve(size_t n) {
+        if (used + n > buffer.size()) flush();
+        return buffer.data() + used;
+    }
+
+    void commit(size_t n) { used += n; }
+
+    void write(const void* data, size_t n) {
+        std::memcpy(reserve(n), data, n);
+        commit(n);
+    }
+
+    uint64_t checksum() {
+        flush();
+        return hash;
+    }
+
+    void flush() {
+        if (used == 0) return;
+        hash = fnv1a(hash, buffer.data(), used);
+        if (!failed && std::fwrite(buffer.data(), 1, used, file) != used) failed = true;
+        total += used;
+        used = 0;
+    }
+
+    // Сбрасывает буфер и закрывает файл; false при ошибке записи
+    bool close() {
+        if (!file) return false;
+        flush();
+        if (owned) {
+            if (std::fclose(file) != 0) failed = true;
+        } else if (std::fflush(file) != 0) {
+            failed = true;
+        }
+        file = nullptr;
+        return !failed;
+    }
+
+private:
+    std::FILE* file;
+    bool owned;
+    bool failed;
+    std::vector<uint8_t> buffer;
+    size_t used;
+    uint64_t total;
+    uint64_t hash;
+};
+
+// Запись простых в формате csv или bin по мере нахождения
+class PrimeWriter {
+public:
+    PrimeWriter(OutputFormat fmt, const std::string& path)
+        : format(fmt), out(path), count(0), previous(0), valueTooLong(false) {
+        if (format == OutputFormat::Bin) {
+            uint8_t header[PRIME_FILE_HEADER] = {};
+            std::memcpy(header, PRIME_FILE_MAGIC, sizeof(PRIME_FILE_MAGIC));
+            header[4] = PRIME_FILE_VERSION;
+            storeLE(header + 8, PRIME_FILE_BLOCK, 4);
+            out.write(header, sizeof(header));
+        } else {
+            out.write("index,prime\n", 12);
+        }
+    }
+
+    bool good() const { return out.good() && !valueTooLong; }
+
+    void add(uint64_t p) {
+        if (format == OutputFormat::Bin) {
+            uint8_t* dst = out.reserve(VARINT_MAX_BYTES);
+            if (count % PRIME_FILE_BLOCK == 0) {
+                blockOffsets.push_back(out.offset());
+                out.commit(encodeVarint(dst, p));
+            } else {
+                out.commit(encodeVarint(dst, zigzagEncode(static_cast<int64_t>(p - previous))));
+            }
+            previous = p;
+        } else {
+            char* dst = reinterpret_cast<char*>(out.reserve(48));
+            char* end = std::to_chars(dst, dst + 20, count + 1).ptr;
+            *end++ = ',';
+            end = std::to_chars(end, end + 20, p).ptr;
+            *end++ = '\n';
+            out.commit(end - dst);
+        }
+        ++count;
+    }
+
+    // Числа длиннее 64 бит пишутся только в csv
+    template<int LIMBS>
+    void add(const BigUInt<LIMBS>& p) {
+        if (p.bitLength() <= 64) {
+            add(p.limb[0]);
+        } else if (format == OutputFormat::Bin) {
+            valueTooLong = true;
+        } else {
+            const std::string row = std::to_string(count + 1) + "," + p.toString() + "\n";
+            out.write(row.data(), row.size());
+            ++count;
+        }
+    }
+
+    // Дописывает индекс и хвост; false при ошибке записи
+    bool finish() {
+        if (format == OutputFormat::Bin) {
+            uint8_t field[8];
+            for (uint64_t offset : blockOffsets) {
+                storeLE(field, offset, 8);
+                out.write(field, sizeof(field));
+            }
+            storeLE(field, count, 8);
+            out.write(field, sizeof(field));
+            uint8_t sum[8];
+            storeLE(sum, out.checksum(), 8);
+            out.write(sum, sizeof(sum));
+        }
+        return out.close() && !valueTooLong;
+    }
+
+    uint64_t size() const { return count; }
+
+private:
+    OutputFormat format;
+    BufferedOutput out;
+    uint64_t count;
+    uint64_t previous;
+    bool valueTooLong;
+    std::vector<uint64_t> blockOffsets;
+};
+
+// Записывает готовый список простых (csv или bin)
+template<typename T>
+bool writePrimes(const std::vector<T>& primes, OutputFormat format, const std::string& path) {
+    PrimeWriter writer(format, path);
+    for (const T& p : primes) writer.add(p);
+    return writer.finish();
+}
+
+// Двоичный файл простых, отображённый в память. Заголовок, индекс и
+// смещения блоков проверяются при открытии; содержимое блоков -
+// через checksumOk().
+class PrimeFileReader {
+public:
+    explicit PrimeFileReader(const std::string& path)
+        : file(path), ok(false), count(0), blockSize(0), blocks(0), index(nullptr), indexStart(0) {
+        const uint8_t* data = file.data();
+        const size_t size = file.size();
+        if (!file.valid() || size < PRIME_FILE_HEADER + PRIME_FILE_TRAILER) return;
+        if (std::memcmp(data, PRIME_FILE_MAGIC, sizeof(PRIME_FILE_MAGIC)) != 0 ||
+            data[4] != PRIME_FILE_VERSION) {
+            return;
+        }
+        blockSize = static_cast<uint32_t>(loadLE(data + 8, 4));
+        const uint64_t records = loadLE(data + size - PRIME_FILE_TRAILER, 8);
+        if (blockSize == 0) return;
+
+        const uint64_t blockCount = records / blockSize + (records % blockSize != 0);
+        const size_t room = size - PRIME_FILE_HEADER - PRIME_FILE_TRAILER;
+        if (blockCount > room / 8) return;
+        indexStart = size - PRIME_FILE_TRAILER - 8 * blockCount;
+
+        // Смещения блоков возрастают и лежат между заголовком и индексом;
+        // на каждое число приходится хотя бы один байт
+        uint64_t previousOffset = PRIME_FILE_HEADER;
+        for (uint64_t b = 0; b < blockCount; ++b) {
+            const uint64_t offset = loadLE(data + indexStart + 8 * b, 8);
+            if (offset < previousOffset || offset >= indexStart) return;
+            if (b > 0 && offset - previousOffset < blockSize) return;
+            previousOffset = offset;
+        }
+        if (blockCount > 0 && indexStart - previousOffset < records - (blockCount - 1) * blockSize) return;
+
+        count = records;
+        blocks = blockCount;
+        index = data + indexStart;
+        ok = true;
+    }
+
+    // false, если файла нет, он пуст или заголовок и индекс испорчены
+    bool valid() const { return ok; }
+
+    size_t size() const { return count; }
+
+    // Число с номером i (i < size()); 0, если блок испорчен
+    uint64_t operator[](size_t i) const {
+        const uint64_t block = i / blockSize;
+        const uint8_t* pos = file.data() + blockOffset(block);
+        const uint8_t* end = file.data() + blockEnd(block);
+        bool failed = false;
+        uint64_t value = readVarint(pos, end, failed);
+        for (size_t j = block * blockSize; j < i && !failed; ++j) {
+            value += static_cast<uint64_t>(zigzagDecode(readVarint(pos, end, failed)));
+        }
+        return failed ? 0 : value;
+    }
+
+    // Вызывает fn(p) для всех чисел по порядку; false, если данные испорчены
+    template<typename Fn>
+    bool forEach(Fn fn) const {
+        for (uint64_t block = 0; block < blocks; ++block) {
+            const uint8_t* pos = file.data() + blockOffset(block);
+            const uint8_t* end = file.data() + blockEnd(block);
+            const uint64_t members = std::min<uint64_t>(blockSize, count - block * blockSize);
+            bool failed = false;
+            uint64_t value = readVarint(pos, end, failed);
+            fn(value);
+            for (uint64_t j = 1; j < members; ++j) {
+                value += static_cast<uint64_t>(zigzagDecode(readVarint(pos, end, failed)));
+                if (failed) return false;
+                fn(value);
+            }
+            if (failed || pos != end) return false;
+        }
+        return true;
+    }
+
+    bool checksumOk() const {
+        if (!valid()) return false;
+        const size_t covered = file.size() - 8;
+        return fnv1a(FNV_OFFSET, file.data(), covered) == loadLE(file.data() + covered, 8);
+    }
+
+private:
+    uint64_t blockOffset(uint64_t block) const {
+        return loadLE(index + 8 * block, 8);
+    }
+
+    uint64_t blockEnd(uint64_t block) const {
+        return block + 1 < blocks ? blockOffset(block + 1) : indexStart;
+    }
+
+    MappedFile file;
+    bool ok;
+    uint64_t count;
+    uint32_t blockSize;
+    uint64_t blocks;
+    const uint8_t* index;
+    size_t indexStart;
+};
+
+#endif // LABA3_PRIMEIO_H
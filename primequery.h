@@ -0,0 +1,149 @@
+// Запросы о простых числах для режима обслуживания (primeserve.cpp)
+//
+// Числа до границы таблицы primeTable() отвечаются по её битам и
+// индексу, большие - детерминированным Миллером-Рабином (точен для
+// всех 64-битных n), диапазоны за таблицей - сегментированным решетом,
+// а слишком длинные для решета - методом Люси (primecount.h).
+
+#ifndef LABA3_PRIMEQUERY_H
+#define LABA3_PRIMEQUERY_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "bigprime.h"
+#include "multiversion.h"
+#include "primality.h"
+#include "primecache.h"
+#include "primecount.h"
+#include "rng.h"
+#include "sieve.h"
+
+// Наибольшее 64-битное простое
+const uint64_t LARGEST_PRIME_64 = 18446744073709551557ULL;
+// Длина диапазона count_primes за таблицей, который просеивается целиком;
+// более длинные считаются как pi(B) - pi(A - 1)
+const uint64_t QUERY_MAX_SIEVE_RANGE = uint64_t(1) << 34;
+// Наибольшее B для pi(B) - pi(A - 1): pi(10^13) - около секунд
+const uint64_t QUERY_MAX_COUNT_BOUND = 10000000000000ULL;
+// Простые для быстрого отсева перед Миллером-Рабином
+const int QUERY_TRIAL_PRIMES = 16;
+
+inline bool queryIsPrime(uint64_t n) {
+    const PrimeTable& table = primeTable();
+    if (n <= table.limit()) return table.isPrime(n);
+    for (int i = 0; i < QUERY_TRIAL_PRIMES; ++i) {
+        if (n % SMALL_PRIMES[i] == 0) return n == SMALL_PRIMES[i];
+    }
+    return millerRabinDeterministic(n);
+}
+
+// Наименьшее простое больше n; false, если оно не помещается в 64 бита
+inline bool queryNextPrime(uint64_t n, uint64_t& p) {
+    if (n >= LARGEST_PRIME_64) return false;
+    const PrimeTable& table = primeTable();
+    if (n < table.limit()) {
+        p = table.nextPrime(n);
+        if (p) return true;
+        n = table.limit();
+    }
+    p = n + 1 + (n % 2); // первое нечётное больше n
+    while (!queryIsPrime(p)) p += 2;
+    return true;
+}
+
+// Наибольшее простое меньше n; false, если n <= 2
+inline bool queryPrevPrime(uint64_t n, uint64_t& p) {
+    if (n <= 2) return false;
+    const PrimeTable& table = primeTable();
+    if (n <= table.limit() + 1) {
+        p = table.prevPrime(n);
+        return true;
+    }
+    p = n - 1 - (n % 2 == 0 ? 0 : 1); // последнее нечётное меньше n
+    while (p > table.limit()) {
+        if (queryIsPrime(p)) return true;
+        p -= 2;
+    }
+    p = table.prevPrime(table.limit() + 1);
+    return true;
+}
+
+// Число простых в [low, high] сегментированным решетом
+LABA3_MULTIVERSION
+inline uint64_t sieveCountRange(uint64_t low, uint64_t high) {
+    if (low > high) return 0;
+    const std::vector<uint32_t> basePrimes = sievePrimes(static_cast<uint64_t>(std::sqrt((double)high)) + 1);
+    std::vector<uint64_t> bits;
+    uint64_t count = low <= 2 && high >= 2;
+
+    // Бит i сегмента - число segment + 2i + 1
+    for (uint64_t segment = low / SIEVE_SEGMENT_SPAN * SIEVE_SEGMENT_SPAN; segment <= high;
+         segment += SIEVE_SEGMENT_SPAN) {
+        sieveSegment(segment, basePrimes, bits);
+        const uint64_t first = low > segment ? (low - segment) / 2 : 0;                // нечётные >= low
+        const uint64_t last = std::min(SIEVE_SEGMENT_SPAN / 2, (high - segment + 1) / 2); // нечётные <= high
+        for (uint64_t i = first; i < last; ) {
+            if (i % 64 == 0 && i + 64 <= last) {
+                count += __builtin_popcountll(~bits[i / 64]);
+                i += 64;
+            } else {
+                count += !((bits[i / 64] >> (i % 64)) & 1);
+                ++i;
+            }
+        }
+        if (segment > high - SIEVE_SEGMENT_SPAN) break; // следующий сегмент переполнил бы uint64
+    }
+    return count;
+}
+
+// Число простых в [low, high]; false, если часть за таблицей длиннее
+// QUERY_MAX_SIEVE_RANGE, а high больше QUERY_MAX_COUNT_BOUND
+inline bool queryCountPrimes(uint64_t low, uint64_t high, uint64_t& count) {
+    count = 0;
+    if (low > high) return true;
+    const PrimeTable& table = primeTable();
+    if (low <= table.limit()) {
+        const uint64_t top = std::min(high, table.limit());
+        count = table.countUpTo(top) - (low > 0 ? table.countUpTo(low - 1) : 0);
+        if (high <= table.limit()) return true;
+        low = table.limit() + 1;
+    }
+    if (high - low < QUERY_MAX_SIEVE_RANGE) {
+        count += sieveCountRange(low, high);
+    } else if (high <= QUERY_MAX_COUNT_BOUND) {
+        count += countPrimesRange(low, high);
+    } else {
+        return false;
+    }
+    return true;
+}
+
+// Случайное простое ровно из bits бит (2..4096) в десятичной записи.
+// До 64 бит - случайное нечётное с проверкой, длиннее - построение
+// Поклингтона из bigprime.h.
+inline bool queryRandomPrime(int bits, Xoshiro256& gen, std::string& out) {
+    if (bits == 2) {
+        out = gen() & 1 ? "3" : "2";
+        return true;
+    }
+    if (bits > 2 && bits <= 64) {
+        const uint64_t top = uint64_t(1) << (bits - 1);
+        const uint64_t mask = bits == 64 ? ~uint64_t(0) : (top << 1) - 1;
+        uint64_t n;
+        do {
+            n = (gen() & mask) | top | 1;
+        } while (!queryIsPrime(n));
+        out = std::to_string(n);
+        return true;
+    }
+    return withLimbsForBits(bits, [&](auto limbs) {
+        constexpr int LIMBS = decltype(limbs)::value;
+        out = pocklingtonPrimeBig<LIMBS>(bits, gen).toString();
+    });
+}
+
+#endif // LABA3_PRIMEQUERY_H
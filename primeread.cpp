@@ -0,0 +1,59 @@
+// Чтение двоичного файла простых (--format bin)
+//
+// Запуск:
+//   primeread FILE [--at I] [--all]
+// Печатает число записей и результат сверки контрольной суммы;
+// --at I - число с номером I (с 1), --all - все числа по порядку.
+// Код возврата 1, если файл не читается или контрольная сумма не совпала.
+
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+#include "primeio.h"
+
+using namespace std;
+
+int main(int argc, char* argv[]) {
+    string path;
+    long long at = 0;   // --at I: номер числа для вывода (0 - не выводить)
+    bool all = false;   // --all: вывести все числа
+
+    for (int i = 1; i < argc; ++i) {
+        string arg = argv[i];
+        if (arg == "--at" && i + 1 < argc) {
+            at = atoll(argv[++i]);
+        } else if (arg == "--all") {
+            all = true;
+        } else {
+            path = arg;
+        }
+    }
+    if (path.empty()) {
+        cerr << "Использование: primeread FILE [--at I] [--all]\n";
+        return 1;
+    }
+
+    PrimeFileReader reader(path);
+    if (!reader.valid()) {
+        cerr << "Не удалось прочитать " << path << " (нет файла или неверный формат)\n";
+        return 1;
+    }
+
+    const bool intact = reader.checksumOk();
+    cout << "Чисел: " << reader.size() << ", контрольная сумма: " << (intact ? "верна" : "НЕ совпадает") << "\n";
+
+    if (at > 0) {
+        if (static_cast<unsigned long long>(at) > reader.size()) {
+            cerr << "--at: в файле " << reader.size() << " чисел\n";
+            return 1;
+        }
+        cout << "№" << at << ": " << reader[at - 1] << "\n";
+    }
+    if (all && !reader.forEach([](uint64_t p) { cout << p << "\n"; })) {
+        cerr << "Данные в " << path << " повреждены\n";
+        return 1;
+    }
+
+    return intact ? 0 : 1;
+}
@@ -0,0 +1,273 @@
+// Долгоживущий сервис запросов о простых числах
+//
+// Запуск:
+//   primeserve [--socket PATH] [--limit N] [--cache FILE] [--seed S]
+// Без --socket команды читаются из stdin, ответы пишутся в stdout;
+// с --socket сервис слушает Unix-сокет PATH, каждое соединение
+// обслуживается своим потоком. Таблица простых (primecache.h)
+// загружается один раз при старте.
+//
+// Команды - по одной в строке, ответ - одна строка на команду:
+//   is_prime N          -> 1 или 0
+//   next_prime N        -> наименьшее простое > N
+//   prev_prime N        -> наибольшее простое < N
+//   count_primes A B    -> число простых в [A, B]
+//   random_prime BITS [K] -> K (по умолчанию 1) простых ровно из BITS бит
+// На неверную команду отвечается "error <причина>". Ответы копятся в
+// буфере и отправляются, когда прочитаны все уже пришедшие команды,
+// поэтому клиент может слать запросы пачками, не дожидаясь ответов.
+
+#include <cerrno>
+#include <charconv>
+#include <csignal>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <thread>
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "primecache.h"
+#include "primequery.h"
+#include "rng.h"
+
+using namespace std;
+
+const size_t SERVE_BUFFER = 1 << 16;
+// Наибольшее K в random_prime: ответ - одна строка
+const uint64_t SERVE_MAX_RANDOM = 100000;
+
+// Построчное чтение из дескриптора с буфером
+class LineReader {
+public:
+    explicit LineReader(int descriptor) : fd(descriptor), buffer(SERVE_BUFFER, '\0'), begin(0), end(0) {}
+
+    // true, если в буфере есть полная строка (чтение не понадобится)
+    bool hasLine() const {
+        return memchr(buffer.data() + begin, '\n', end - begin) != nullptr;
+    }
+
+    // Следующая строка без '\n'; false в конце ввода
+    bool next(string_view& line) {
+        while (true) {
+            const char* start = buffer.data() + begin;
+            const char* newline = static_cast<const char*>(memchr(start, '\n', end - begin));
+            if (newline) {
+                line = string_view(start, newline - start);
+                begin += newline - start + 1;
+                return true;
+            }
+            // Сдвигаем хвост в начало и дочитываем
+            memmove(buffer.data(), start, end - begin);
+            end -= begin;
+            begin = 0;
+            if (end == buffer.size()) buffer.resize(buffer.size() * 2);
+            ssize_t got = ::read(fd, buffer.data() + end, buffer.size() - end);
+            if (got < 0 && errno == EINTR) continue;
+            if (got <= 0) {
+                if (end == 0) return false;
+                line = string_view(buffer.data(), end); // последняя строка без '\n'
+                begin = end;
+                return true;
+            }
+            end += got;
+        }
+    }
+
+private:
+    int fd;
+    string buffer;
+    size_t begin;
+    size_t end;
+};
+
+// Буферизованная запись ответов в дескриптор
+class ReplyWriter {
+public:
+    explicit ReplyWriter(int descriptor) : fd(descriptor), closed(false) { out.reserve(SERVE_BUFFER); }
+    ~ReplyWriter() { flush(); }
+
+    void line(const string& text) {
+        out += text;
+        out += '\n';
+        if (out.size() >= SERVE_BUFFER) flush();
+    }
+
+    void number(uint64_t value) {
+        char digits[24];
+        char* end = to_chars(digits, digits + sizeof(digits), value).ptr;
+        *end++ = '\n';
+        out.append(digits, end - digits);
+        if (out.size() >= SERVE_BUFFER) flush();
+    }
+
+    // false, если собеседник закрыл соединение (EPIPE и прочие ошибки
+    // записи): дальнейшие ответы этому собеседнику отбрасываются
+    bool flush() {
+        size_t done = 0;
+        while (!closed && done < out.size()) {
+            ssize_t put = ::write(fd, out.data() + done, out.size() - done);
+            if (put < 0 && errno == EINTR) continue;
+            if (put <= 0) {
+                closed = true;
+                break;
+            }
+            done += put;
+        }
+        out.clear();
+        return !closed;
+    }
+
+    bool open() const { return !closed; }
+
+private:
+    int fd;
+    string out;
+    bool closed;
+};
+
+// Следующее слово строки; пустое, если слов больше нет
+string_view nextWord(string_view& rest) {
+    size_t start = rest.find_first_not_of(" \t\r");
+    if (start == string_view::npos) {
+        rest = string_view();
+        return rest;
+    }
+    size_t stop = rest.find_first_of(" \t\r", start);
+    if (stop == string_view::npos) stop = rest.size();
+    string_view word = rest.substr(start, stop - start);
+    rest.remove_prefix(stop);
+    return word;
+}
+
+bool parseNumber(string_view word, uint64_t& value) {
+    if (word.empty()) return false;
+    auto result = from_chars(word.data(), word.data() + word.size(), value);
+    return result.ec == errc() && result.ptr == word.data() + word.size();
+}
+
+// Выполняет одну команду и пишет ответ
+void answer(string_view request, ReplyWriter& reply, Xoshiro256& gen) {
+    string_view rest = request;
+    const string_view command = nextWord(rest);
+    uint64_t a = 0, b = 0;
+
+    if (command.empty()) {
+        reply.line("error пустая команда");
+    } else if (command == "is_prime") {
+        if (!parseNumber(nextWord(rest), a)) return reply.line("error is_prime N");
+        reply.number(queryIsPrime(a));
+    } else if (command == "next_prime") {
+        if (!parseNumber(nextWord(rest), a)) return reply.line("error next_prime N");
+        if (!queryNextPrime(a, b)) return reply.line("error нет 64-битного простого больше N");
+        reply.number(b);
+    } else if (command == "prev_prime") {
+        if (!parseNumber(nextWord(rest), a)) return reply.line("error prev_prime N");
+        if (!queryPrevPrime(a, b)) return reply.line("error нет простых меньше N");
+        reply.number(b);
+    } else if (command == "count_primes") {
+        if (!parseNumber(nextWord(rest), a) || !parseNumber(nextWord(rest), b)) {
+            return reply.line("error count_primes A B");
+        }
+        uint64_t count;
+        if (!queryCountPrimes(a, b, count)) return reply.line("error диапазон за таблицей слишком длинный");
+        reply.number(count);
+    } else if (command == "random_prime") {
+        uint64_t k = 1;
+        const bool bitsGiven = parseNumber(nextWord(rest), a);
+        const string_view countWord = nextWord(rest);
+        if (!bitsGiven || a < 2 || a > 4096 || (!countWord.empty() && !parseNumber(countWord, k)) ||
+            k > SERVE_MAX_RANDOM) {
+            return reply.line("error random_prime BITS [K], BITS от 2 до 4096, K до 100000");
+        }
+        string text, prime;
+        for (uint64_t i = 0; i < k; ++i) {
+            queryRandomPrime(static_cast<int>(a), gen, prime);
+            if (i) text += ' ';
+            text += prime;
+        }
+        reply.line(text);
+    } else {
+        reply.line("error неизвестная команда " + string(command));
+    }
+}
+
+// Обслуживает один поток команд до конца ввода или до закрытия
+// соединения; stream - последовательность случайных чисел этого потока
+void serve(int in, int out, const Xoshiro256& stream) {
+    Xoshiro256& gen = threadRng();
+    gen = stream;
+    LineReader reader(in);
+    ReplyWriter reply(out);
+    string_view request;
+    while (reader.next(request)) {
+        answer(request, reply, gen);
+        // Ответы уходят, когда пришедшие команды кончились
+        if (!reply.open() || (!reader.hasLine() && !reply.flush())) return;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    string socketPath;  // --socket PATH: слушать Unix-сокет вместо stdin
+
+    for (int i = 1; i < argc; ++i) {
+        string arg = argv[i];
+        if (arg == "--socket" && i + 1 < argc) {
+            socketPath = argv[++i];
+        } else if (arg == "--limit" && i + 1 < argc) {
+            primeTableLimit = strtoull(argv[++i], nullptr, 10); // граница таблицы простых
+        } else if (arg == "--cache" && i + 1 < argc) {
+            primeTableCache = argv[++i]; // файл таблицы ("-" - без файла)
+        } else if (arg == "--seed" && i + 1 < argc) {
+            setMasterSeed(strtoull(argv[++i], nullptr, 10)); // воспроизводимые random_prime
+        }
+    }
+
+    primeTable(); // таблица загружается до первого запроса
+
+    // Ушедший клиент не должен останавливать сервис: вместо SIGPIPE
+    // запись вернёт EPIPE, и соединение просто закроется
+    signal(SIGPIPE, SIG_IGN);
+
+    if (socketPath.empty()) {
+        serve(0, 1, Xoshiro256(masterSeed(), 0));
+        return 0;
+    }
+
+    int listener = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    sockaddr_un address = {};
+    address.sun_family = AF_UNIX;
+    if (listener < 0 || socketPath.size() >= sizeof(address.sun_path)) {
+        cerr << "Не удалось создать сокет " << socketPath << "\n";
+        return 1;
+    }
+    strcpy(address.sun_path, socketPath.c_str());
+    ::unlink(socketPath.c_str());
+    if (::bind(listener, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 ||
+        ::listen(listener, 64) != 0) {
+        cerr << "Не удалось слушать " << socketPath << ": " << strerror(errno) << "\n";
+        return 1;
+    }
+
+    // Соединение номер id получает последовательность id (как
+    // seedThreadRng(id)), но без id прыжков на каждое: следующая
+    // последовательность - один прыжок от предыдущей
+    Xoshiro256 stream(masterSeed(), 1);
+    for (;;) {
+        int client = ::accept(listener, nullptr, nullptr);
+        if (client < 0) {
+            if (errno == EINTR) continue;
+            cerr << "accept: " << strerror(errno) << "\n";
+            return 1;
+        }
+        thread([client, stream] {
+            serve(client, client, stream);
+            ::close(client);
+        }).detach();
+        stream.jump();
+    }
+}
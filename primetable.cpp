@@ -0,0 +1,53 @@
+// Таблица простых с кэшем на диске: построение, загрузка и запросы
+//
+// Запуск:
+//   primetable [--limit N] [--cache FILE] [n ...]
+// Первый запуск с данной границей строит решето (во всех ядрах) и
+// сохраняет его в FILE (по умолчанию - каталог кэша пользователя,
+// "-" - без файла); следующие только отображают файл в память.
+// Для каждого n печатается, простое ли оно, и pi(n).
+
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "primecache.h"
+
+using namespace std;
+
+int main(int argc, char* argv[]) {
+    vector<uint64_t> queries;
+
+    for (int i = 1; i < argc; ++i) {
+        string arg = argv[i];
+        if (arg == "--limit" && i + 1 < argc) {
+            primeTableLimit = strtoull(argv[++i], nullptr, 10); // граница таблицы, до 2^32
+        } else if (arg == "--cache" && i + 1 < argc) {
+            primeTableCache = argv[++i];
+        } else {
+            queries.push_back(strtoull(arg.c_str(), nullptr, 10));
+        }
+    }
+
+    const auto start = chrono::steady_clock::now();
+    const PrimeTable& table = primeTable();
+    const double elapsed = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    cout << "Граница: " << table.limit() << ", простых: " << table.primeCount() << "\n";
+    cout << fixed << setprecision(3) << (table.mapped() ? "Загружено из файла" : "Построено решетом")
+         << " за " << elapsed * 1000 << " мс\n";
+
+    for (uint64_t n : queries) {
+        if (n > table.limit()) {
+            cerr << n << ": больше границы таблицы\n";
+            return 1;
+        }
+        cout << n << ": " << (table.isPrime(n) ? "простое" : "составное")
+             << ", pi = " << table.countUpTo(n) << "\n";
+    }
+
+    return 0;
+}
@@ -0,0 +1,104 @@
+// Генератор случайных чисел xoshiro256** с потоками на каждый поток ОС
+//
+// Вместо random_device + mt19937 на каждый вызов: один главный seed
+// (--seed или random_device при старте), из которого каждый поток
+// получает свою независимую последовательность. Состояние - 32 байта,
+// вызов random_device - один на процесс.
+
+#ifndef LABA3_RNG_H
+#define LABA3_RNG_H
+
+#include <cstdint>
+#include <limits>
+#include <random>
+
+// splitmix64 - расширяет одно 64-битное значение до состояния xoshiro
+inline uint64_t splitmix64(uint64_t& x) {
+    uint64_t z = (x += 0x9e3779b97f4a7c15ULL);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31);
+}
+
+// xoshiro256** (Blackman, Vigna). Удовлетворяет требованиям
+// UniformRandomBitGenerator, поэтому работает со стандартными распределениями.
+class Xoshiro256 {
+public:
+    typedef uint64_t result_type;
+
+    Xoshiro256() : Xoshiro256(0, 0) {}
+
+    // Последовательность номер stream для главного значения seed:
+    // состояние из seed, затем stream прыжков по 2^128 шагов,
+    // так что последовательности разных потоков не пересекаются.
+    Xoshiro256(uint64_t seed, uint64_t stream) {
+        for (uint64_t& word : s) word = splitmix64(seed);
+        for (uint64_t i = 0; i < stream; ++i) jump();
+    }
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return std::numeric_limits<uint64_t>::max(); }
+
+    result_type operator()() {
+        const uint64_t result = rotl(s[1] * 5, 7) * 9;
+        const uint64_t t = s[1] << 17;
+        s[2] ^= s[0];
+        s[3] ^= s[1];
+        s[1] ^= s[2];
+        s[0] ^= s[3];
+        s[2] ^= t;
+        s[3] = rotl(s[3], 45);
+        return result;
+    }
+
+    // Эквивалент 2^128 вызовов operator()
+    void jump() {
+        static const uint64_t JUMP[] = {0x180ec6d33cfd0abaULL, 0xd5a61266f0c9392cULL,
+                                        0xa9582618e03fc9aaULL, 0x39abdc4529b1661cULL};
+        uint64_t t[4] = {0, 0, 0, 0};
+        for (uint64_t mask : JUMP) {
+            for (int b = 0; b < 64; ++b) {
+                if (mask & (uint64_t(1) << b)) {
+                    for (int i = 0; i < 4; ++i) t[i] ^= s[i];
+                }
+                (*this)();
+            }
+        }
+        for (int i = 0; i < 4; ++i) s[i] = t[i];
+    }
+
+private:
+    static uint64_t rotl(uint64_t x, int k) {
+        return (x << k) | (x >> (64 - k));
+    }
+
+    uint64_t s[4];
+};
+
+// Главное значение seed процесса (по умолчанию - из random_device)
+inline uint64_t& masterSeed() {
+    static uint64_t seed = (uint64_t(std::random_device{}()) << 32) ^ std::random_device{}();
+    return seed;
+}
+
+inline void setMasterSeed(uint64_t seed) {
+    masterSeed() = seed;
+}
+
+// Генератор текущего потока. Пока поток не вызвал seedThreadRng,
+// он использует последовательность 0.
+inline Xoshiro256& threadRng() {
+    thread_local Xoshiro256 rng(masterSeed(), 0);
+    return rng;
+}
+
+// Переводит генератор текущего потока на последовательность stream.
+// Рабочие потоки вызывают её со своим номером, и при одинаковом --seed
+// каждый поток получает одни и те же числа от запуска к запуску.
+inline Xoshiro256& seedThreadRng(uint64_t stream) {
+    Xoshiro256& rng = threadRng();
+    rng = Xoshiro256(masterSeed(), stream);
+    return rng;
+}
+
+#endif // LABA3_RNG_H
@@ -0,0 +1,278 @@
+// Сегментированное решето Эратосфена
+//
+// Хранятся только нечётные числа, по одному биту на число. Сегмент
+// занимает SIEVE_SEGMENT_BYTES и помещается в кэш L1, поэтому вычёркивание
+// не выходит за пределы кэша при любой верхней границе.
+
+#ifndef LABA3_SIEVE_H
+#define LABA3_SIEVE_H
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+// Размер сегмента в байтах (32 КБ - типичный L1 данных)
+const uint64_t SIEVE_SEGMENT_BYTES = 32 * 1024;
+// Сколько чисел покрывает один сегмент (бит на нечётное число)
+const uint64_t SIEVE_SEGMENT_SPAN = SIEVE_SEGMENT_BYTES * 8 * 2;
+
+// Простое решето для маленьких границ (базовые простые до sqrt(limit))
+inline std::vector<uint32_t> simpleSieve(uint32_t limit) {
+    std::vector<uint32_t> result;
+    if (limit < 2) return result;
+
+    std::vector<bool> composite(limit + 1, false);
+    for (uint64_t p = 2; p * p <= limit; ++p) {
+        if (!composite[p]) {
+            for (uint64_t i = p * p; i <= limit; i += p) {
+                composite[i] = true;
+            }
+        }
+    }
+    for (uint32_t i = 2; i <= limit; ++i) {
+        if (!composite[i]) result.push_back(i);
+    }
+    return result;
+}
+
+// Просеивает нечётные числа [low, low + SIEVE_SEGMENT_SPAN), low чётное.
+// Бит i сегмента соответствует числу low + 2i + 1; установленный бит - составное.
+// basePrimes должны содержать все простые до sqrt(low + SIEVE_SEGMENT_SPAN).
+inline void sieveSegment(uint64_t low, const std::vector<uint32_t>& basePrimes, std::vector<uint64_t>& bits) {
+    bits.assign(SIEVE_SEGMENT_BYTES / 8, 0);
+    const uint64_t high = low + SIEVE_SEGMENT_SPAN;
+
+    for (uint32_t p : basePrimes) {
+        if (p == 2) continue;
+        const uint64_t pp = uint64_t(p) * p;
+        if (pp >= high) break;
+
+        // Первое нечётное кратное p в сегменте, не меньше p^2
+        uint64_t start = std::max(pp, (low + p - 1) / p * p);
+        if (start % 2 == 0) start += p;
+
+        for (uint64_t i = (start - low - 1) / 2; i < SIEVE_SEGMENT_SPAN / 2; i += p) {
+            bits[i / 64] |= uint64_t(1) << (i % 64);
+        }
+    }
+    if (low == 0) bits[0] |= 1; // 1 не простое
+}
+
+// Дописывает простые сегмента [low, low + SIEVE_SEGMENT_SPAN) не больше limit
+inline void collectSegment(uint64_t low, uint64_t limit, const std::vector<uint64_t>& bits,
+                           std::vector<uint32_t>& out) {
+    for (size_t w = 0; w < bits.size(); ++w) {
+        uint64_t word = ~bits[w];
+        while (word) {
+            uint64_t value = low + 2 * (w * 64 + __builtin_ctzll(word)) + 1;
+            if (value > limit) return;
+            out.push_back(static_cast<uint32_t>(value));
+            word &= word - 1;
+        }
+    }
+}
+
+// Все простые до limit включительно (limit < 2^32).
+// При threads > 1 сегменты делятся между потоками по кругу,
+// а результаты склеиваются по порядку сегментов.
+inline std::vector<uint32_t> sievePrimes(uint64_t limit, unsigned threads = 1) {
+    std::vector<uint32_t> result;
+    if (limit < 2) return result;
+
+    const std::vector<uint32_t> basePrimes = simpleSieve(static_cast<uint32_t>(std::sqrt((double)limit)) + 1);
+    const uint64_t segments = limit / SIEVE_SEGMENT_SPAN + 1;
+    threads = std::max(1u, std::min<unsigned>(threads, static_cast<unsigned>(segments)));
+
+    std::vector<std::vector<uint32_t>> parts(segments);
+    auto worker = [&](unsigned id) {
+        std::vector<uint64_t> bits;
+        for (uint64_t s = id; s < segments; s += threads) {
+            const uint64_t low = s * SIEVE_SEGMENT_SPAN;
+            sieveSegment(low, basePrimes, bits);
+            collectSegment(low, limit, bits, parts[s]);
+        }
+    };
+
+    if (threads == 1) {
+        worker(0);
+    } else {
+        std::vector<std::thread> pool;
+        for (unsigned id = 0; id < threads; ++id) {
+            pool.emplace_back(worker, id);
+        }
+        for (std::thread& t : pool) t.join();
+    }
+
+    result.push_back(2);
+    for (const std::vector<uint32_t>& part : parts) {
+        result.insert(result.end(), part.begin(), part.end());
+    }
+    return result;
+}
+
+// Таблица простых до 2^16, общая для всех итераторов (строится один раз).
+// Её хватает как базовых простых для всех чисел до 2^32.
+inline const std::vector<uint32_t>& smallPrimeTable() {
+    static const std::vector<uint32_t> table = sievePrimes(1 << 16);
+    return table;
+}
+
+// Граница таблицы простых, которая строится при компиляции
+constexpr uint32_t SMALL_PRIMES_LIMIT = 1 << 12;
+
+constexpr bool isSmallPrime(uint32_t n) {
+    if (n < 2) return false;
+    for (uint32_t d = 2; d * d <= n; ++d) {
+        if (n % d == 0) return false;
+    }
+    return true;
+}
+
+constexpr size_t countSmallPrimes(uint32_t limit) {
+    size_t count = 0;
+    for (uint32_t n = 2; n < limit; ++n) count += isSmallPrime(n);
+    return count;
+}
+
+template<uint32_t LIMIT>
+constexpr std::array<uint32_t, countSmallPrimes(LIMIT)> makeSmallPrimes() {
+    std::array<uint32_t, countSmallPrimes(LIMIT)> result{};
+    size_t i = 0;
+    for (uint32_t n = 2; n < LIMIT; ++n) {
+        if (isSmallPrime(n)) result[i++] = n;
+    }
+    return result;
+}
+
+// Простые меньше SMALL_PRIMES_LIMIT - для пробного деления и отсева
+// кандидатов; размер известен компилятору, циклы по ней не требуют вектора
+inline constexpr auto SMALL_PRIMES = makeSmallPrimes<SMALL_PRIMES_LIMIT>();
+
+// Ленивый итератор по простым числам 2, 3, 5, ... без верхней границы.
+// Сначала отдаёт готовую таблицу smallPrimeTable(), затем просеивает
+// следующие сегменты по мере надобности.
+class PrimeIterator {
+public:
+    PrimeIterator() : tableIndex(0), low(0), bitIndex(SIEVE_SEGMENT_SPAN / 2) {}
+
+    uint64_t next() {
+        const std::vector<uint32_t>& table = smallPrimeTable();
+        if (tableIndex < table.size()) {
+            return table[tableIndex++];
+        }
+
+        while (true) {
+            if (bitIndex >= SIEVE_SEGMENT_SPAN / 2) {
+                nextSegment(table);
+            }
+            while (bitIndex < SIEVE_SEGMENT_SPAN / 2) {
+                uint64_t i = bitIndex++;
+                if (!((bits[i / 64] >> (i % 64)) & 1)) {
+                    return low + 2 * i + 1;
+                }
+            }
+        }
+    }
+
+private:
+    void nextSegment(const std::vector<uint32_t>& table) {
+        // Первый сегмент начинается сразу за таблицей
+        low = low == 0 ? uint64_t(table.back()) + 1 : low + SIEVE_SEGMENT_SPAN;
+        if (low % 2) ++low;
+
+        // Расширяем базовые простые, если сегмент вышел за 2^32
+        const uint64_t high = low + SIEVE_SEGMENT_SPAN;
+        if (basePrimes.empty()) basePrimes = table;
+        if (uint64_t(basePrimes.back()) * basePrimes.back() < high) {
+            basePrimes = sievePrimes(static_cast<uint64_t>(std::sqrt((double)high)) * 2);
+        }
+
+        sieveSegment(low, basePrimes, bits);
+        bitIndex = 0;
+    }
+
+    size_t tableIndex;
+    uint64_t low;
+    uint64_t bitIndex;
+    std::vector<uint64_t> bits;
+    std::vector<uint32_t> basePrimes;
+};
+
+// Обратный к a по простому модулю p (a не кратно p), расширенный алгоритм Евклида
+inline uint32_t inverseModPrime(uint32_t a, uint32_t p) {
+    int64_t r0 = p, r1 = a % p, x0 = 0, x1 = 1;
+    while (r1 != 0) {
+        int64_t q = r0 / r1;
+        int64_t r = r0 - q * r1; r0 = r1; r1 = r;
+        int64_t x = x0 - q * x1; x0 = x1; x1 = x;
+    }
+    return static_cast<uint32_t>(x0 < 0 ? x0 + p : x0);
+}
+
+// Остаток x по малому модулю (многословные числа добавляют свою перегрузку)
+inline uint32_t smallResidue(uint64_t x, uint32_t p) {
+    return static_cast<uint32_t>(x % p);
+}
+
+// Решето по арифметической прогрессии start + i * step, i = 0, 1, 2, ...
+//
+// Для каждого малого простого p хранится номер ближайшего члена,
+// кратного p (один остаток на простое). Окна прогрессии просеиваются
+// по очереди: кратные вычёркиваются с шагом p, номер сдвигается на
+// длину окна. Уцелевшие члены не имеют делителей до primeLimit, и
+// только они доходят до возведения в степень.
+class ProgressionSieve {
+public:
+    ProgressionSieve() : allComposite(false) {}
+
+    template<typename T>
+    ProgressionSieve(const T& start, const T& step, uint32_t primeLimit) {
+        reset(start, step, primeLimit);
+    }
+
+    // Переход к новой прогрессии без новых выделений памяти
+    template<typename T>
+    void reset(const T& start, const T& step, uint32_t primeLimit) {
+        allComposite = false;
+        primes.clear();
+        next.clear();
+        for (uint32_t p : smallPrimeTable()) {
+            if (p > primeLimit || !(T(p) < start)) break; // член прогрессии мог бы совпасть с p
+            const uint32_t r = smallResidue(start, p);
+            const uint32_t s = smallResidue(step, p);
+            if (s == 0) {
+                allComposite |= (r == 0); // p делит все члены
+                continue;
+            }
+            // r + i * s = 0 (mod p)  =>  i = (p - r) * s^(-1) (mod p)
+            primes.push_back(p);
+            next.push_back(static_cast<uint32_t>(uint64_t((p - r) % p) * inverseModPrime(s, p) % p));
+        }
+    }
+
+    // Следующие count членов прогрессии: бит i в bits установлен,
+    // если у i-го члена окна нет малых делителей
+    void nextWindow(size_t count, std::vector<uint64_t>& bits) {
+        bits.assign((count + 63) / 64, allComposite ? 0 : ~uint64_t(0));
+        if (count % 64) bits.back() &= (uint64_t(1) << (count % 64)) - 1;
+
+        for (size_t k = 0; k < primes.size(); ++k) {
+            const uint32_t p = primes[k];
+            size_t i = next[k];
+            for (; i < count; i += p) {
+                bits[i / 64] &= ~(uint64_t(1) << (i % 64));
+            }
+            next[k] = static_cast<uint32_t>(i - count);
+        }
+    }
+
+private:
+    bool allComposite;
+    std::vector<uint32_t> primes;
+    std::vector<uint32_t> next; // номер ближайшего кратного относительно начала окна
+};
+
+#endif // LABA3_SIEVE_H
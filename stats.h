@@ -0,0 +1,199 @@
+// Счётчики и таймеры горячих путей генераторов
+//
+// Включаются при сборке с -DLABA3_STATS; без этого макросы STAT_*
+// раскрываются в пустые выражения и не стоят ничего. Каждый поток пишет
+// в свой блок счётчиков без синхронизации, блоки суммируются при выходе
+// из программы. Сводка печатается в stderr; если задана переменная
+// окружения LABA3_STATS_JSON=FILE, она же пишется в FILE в виде JSON.
+//
+// Таймеры считают такты RDTSC (на других архитектурах - наносекунды
+// steady_clock) от начала до конца области STAT_TIMER.
+
+#ifndef LABA3_STATS_H
+#define LABA3_STATS_H
+
+#include <cstdint>
+
+enum StatCounter : int {
+    // generateMillerPrimes
+    STAT_MILLER_CANDIDATES,
+    STAT_GENERATE_M_RESTARTS,     // m >= 49999 - набор множителей заново
+    STAT_MILLER_TEST_CALLS,
+    STAT_MILLER_TEST_REJECTS,     // не прошёл millerTest, дальше Миллер-Рабин
+    STAT_MILLER_RABIN_CALLS,
+    STAT_MILLER_RABIN_REJECTS,
+    // generatePocklingtonPrimes
+    STAT_POCK_CANDIDATES,
+    STAT_POCK_TEST_REJECTS,
+    // generateGostPrimes
+    STAT_GOST_MEMBERS,            // членов прогрессии p = (N + u) * q + 1
+    STAT_GOST_SIEVED_OUT,         // отброшено решетом
+    STAT_GOST_FERMAT_REJECTS,     // 2^(p-1) != 1
+    STAT_GOST_DIEMITKO_REJECTS,   // 2^(N+u) = 1
+    STAT_GOST_KSI_RESTARTS,       // прогрессия дошла до 2^t - новое ksi
+    // batchTest: отсеяно пакетным тестом Ферма до вызова теста
+    STAT_BATCH_FERMAT_REJECTS,
+    // PrimeCollector
+    STAT_COLLECTOR_DUPLICATES,
+    STAT_COUNTER_COUNT
+};
+
+enum StatStage : int {
+    STAT_STAGE_MILLER_BUILD,
+    STAT_STAGE_MILLER_TEST,
+    STAT_STAGE_POCK_BUILD,
+    STAT_STAGE_POCK_TEST,
+    STAT_STAGE_GOST_SIEVE,
+    STAT_STAGE_GOST_TEST,
+    STAT_STAGE_COLLECT,
+    STAT_STAGE_COUNT
+};
+
+inline constexpr const char* STAT_COUNTER_NAMES[STAT_COUNTER_COUNT] = {
+    "miller_candidates", "generate_m_restarts", "miller_test_calls", "miller_test_rejects",
+    "miller_rabin_calls", "miller_rabin_rejects",
+    "pock_candidates", "pock_test_rejects",
+    "gost_members", "gost_sieved_out", "gost_fermat_rejects", "gost_diemitko_rejects",
+    "gost_ksi_restarts",
+    "batch_fermat_rejects",
+    "collector_duplicates",
+};
+
+inline constexpr const char* STAT_STAGE_NAMES[STAT_STAGE_COUNT] = {
+    "miller_build", "miller_test", "pock_build", "pock_test", "gost_sieve", "gost_test", "collect",
+};
+
+#ifdef LABA3_STATS
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+inline uint64_t statTicks() {
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+}
+
+// Счётчики одного потока
+struct StatBlock {
+    uint64_t counts[STAT_COUNTER_COUNT] = {};
+    uint64_t calls[STAT_STAGE_COUNT] = {};
+    uint64_t ticks[STAT_STAGE_COUNT] = {};
+};
+
+// Блоки всех потоков; живёт до выхода из программы и печатает сводку
+class StatRegistry {
+public:
+    static StatRegistry& instance() {
+        static StatRegistry registry;
+        return registry;
+    }
+
+    StatBlock* add() {
+        std::lock_guard<std::mutex> lock(mutex);
+        blocks.emplace_back(new StatBlock());
+        return blocks.back().get();
+    }
+
+    ~StatRegistry() {
+        StatBlock sum;
+        for (const std::unique_ptr<StatBlock>& b : blocks) {
+            for (int i = 0; i < STAT_COUNTER_COUNT; ++i) sum.counts[i] += b->counts[i];
+            for (int i = 0; i < STAT_STAGE_COUNT; ++i) {
+                sum.calls[i] += b->calls[i];
+                sum.ticks[i] += b->ticks[i];
+            }
+        }
+        printSummary(sum);
+        if (const char* path = std::getenv("LABA3_STATS_JSON")) writeJson(sum, path);
+    }
+
+private:
+    StatRegistry() = default;
+
+    static void printSummary(const StatBlock& sum) {
+        std::fprintf(stderr, "Счётчики (%zu потоков):\n", instance().blocks.size());
+        for (int i = 0; i < STAT_COUNTER_COUNT; ++i) {
+            if (sum.counts[i]) std::fprintf(stderr, "  %-24s %12llu\n", STAT_COUNTER_NAMES[i],
+                                            (unsigned long long)sum.counts[i]);
+        }
+        uint64_t totalTicks = 0;
+        for (int i = 0; i < STAT_STAGE_COUNT; ++i) totalTicks += sum.ticks[i];
+        std::fprintf(stderr, "Этапы (такты):\n");
+        for (int i = 0; i < STAT_STAGE_COUNT; ++i) {
+            if (!sum.calls[i]) continue;
+            std::fprintf(stderr, "  %-24s %12llu вызовов %16llu тактов %6.1f%% %10.0f на вызов\n",
+                         STAT_STAGE_NAMES[i], (unsigned long long)sum.calls[i],
+                         (unsigned long long)sum.ticks[i], 100.0 * sum.ticks[i] / totalTicks,
+                         (double)sum.ticks[i] / sum.calls[i]);
+        }
+    }
+
+    static void writeJson(const StatBlock& sum, const char* path) {
+        std::FILE* out = std::fopen(path, "w");
+        if (!out) return;
+        std::fprintf(out, "{\n  \"counters\": {");
+        for (int i = 0; i < STAT_COUNTER_COUNT; ++i) {
+            std::fprintf(out, "%s\n    \"%s\": %llu", i ? "," : "", STAT_COUNTER_NAMES[i],
+                         (unsigned long long)sum.counts[i]);
+        }
+        std::fprintf(out, "\n  },\n  \"stages\": {");
+        for (int i = 0; i < STAT_STAGE_COUNT; ++i) {
+            std::fprintf(out, "%s\n    \"%s\": {\"calls\": %llu, \"ticks\": %llu}", i ? "," : "",
+                         STAT_STAGE_NAMES[i], (unsigned long long)sum.calls[i],
+                         (unsigned long long)sum.ticks[i]);
+        }
+        std::fprintf(out, "\n  }\n}\n");
+        std::fclose(out);
+    }
+
+    std::mutex mutex;
+    std::vector<std::unique_ptr<StatBlock>> blocks;
+};
+
+inline StatBlock& statLocal() {
+    thread_local StatBlock* block = StatRegistry::instance().add();
+    return *block;
+}
+
+// Время области видимости в такты этапа stage
+class StatTimer {
+public:
+    explicit StatTimer(StatStage s) : stage(s), start(statTicks()) {}
+    ~StatTimer() {
+        StatBlock& block = statLocal();
+        block.ticks[stage] += statTicks() - start;
+        block.calls[stage]++;
+    }
+
+private:
+    StatStage stage;
+    uint64_t start;
+};
+
+#define STAT_CONCAT_(a, b) a##b
+#define STAT_CONCAT(a, b) STAT_CONCAT_(a, b)
+#define STAT_COUNT(counter) (++statLocal().counts[counter])
+#define STAT_ADD(counter, n) (statLocal().counts[counter] += (n))
+#define STAT_TIMER(stage) StatTimer STAT_CONCAT(statTimer, __LINE__)(stage)
+
+#else
+
+#define STAT_COUNT(counter) ((void)0)
+#define STAT_ADD(counter, n) ((void)0)
+#define STAT_TIMER(stage) ((void)0)
+
+#endif // LABA3_STATS
+
+#endif // LABA3_STATS_H
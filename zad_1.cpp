@@ -1,6 +1,19 @@
 #include <iostream>   // для ввода-вывода
 #include <iomanip>    // для форматирования вывода
 #include <cmath>      // для математических функций
+#include <algorithm>  // для min
+#include <chrono>     // для замера времени в режиме --bench
+#include <cstdint>    // для uint32_t
+#include <cstdio>     // для записи таблицы
+#include <cstdlib>    // для strtoull и strtod
+#include <string>     // для разбора аргументов
+#include <vector>     // для массивов значений
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
 
 using namespace std;
 
@@ -33,10 +46,420 @@ double calculateY(double x) {
     return 0.0;
 }
 
-int main() {
+// Векторные операции над пачкой из LANES чисел double: AVX (4 числа),
+// SSE2 (2 числа) или одно число без SIMD
+#if defined(__AVX__)
+struct Lanes {
+    typedef __m256d V;
+    static const size_t LANES = 4;
+    static V set(double a) { return _mm256_set1_pd(a); }
+    static V ramp() { return _mm256_setr_pd(0.0, 1.0, 2.0, 3.0); }
+    static V load(const double* p) { return _mm256_loadu_pd(p); }
+    static void store(double* p, V a) { _mm256_storeu_pd(p, a); }
+    static V add(V a, V b) { return _mm256_add_pd(a, b); }
+    static V sub(V a, V b) { return _mm256_sub_pd(a, b); }
+    static V mul(V a, V b) { return _mm256_mul_pd(a, b); }
+    static V max(V a, V b) { return _mm256_max_pd(a, b); }
+    static V sqrt(V a) { return _mm256_sqrt_pd(a); }
+    static V le(V a, V b) { return _mm256_cmp_pd(a, b, _CMP_LE_OQ); }
+    static V gt(V a, V b) { return _mm256_cmp_pd(a, b, _CMP_GT_OQ); }
+    static V both(V a, V b) { return _mm256_and_pd(a, b); }
+    static bool any(V mask) { return _mm256_movemask_pd(mask) != 0; }
+    // mask ? a : b
+    static V blend(V mask, V a, V b) { return _mm256_blendv_pd(b, a, mask); }
+};
+#elif defined(__SSE2__)
+struct Lanes {
+    typedef __m128d V;
+    static const size_t LANES = 2;
+    static V set(double a) { return _mm_set1_pd(a); }
+    static V ramp() { return _mm_setr_pd(0.0, 1.0); }
+    static V load(const double* p) { return _mm_loadu_pd(p); }
+    static void store(double* p, V a) { _mm_storeu_pd(p, a); }
+    static V add(V a, V b) { return _mm_add_pd(a, b); }
+    static V sub(V a, V b) { return _mm_sub_pd(a, b); }
+    static V mul(V a, V b) { return _mm_mul_pd(a, b); }
+    static V max(V a, V b) { return _mm_max_pd(a, b); }
+    static V sqrt(V a) { return _mm_sqrt_pd(a); }
+    static V le(V a, V b) { return _mm_cmple_pd(a, b); }
+    static V gt(V a, V b) { return _mm_cmpgt_pd(a, b); }
+    static V both(V a, V b) { return _mm_and_pd(a, b); }
+    static bool any(V mask) { return _mm_movemask_pd(mask) != 0; }
+    static V blend(V mask, V a, V b) { return _mm_or_pd(_mm_and_pd(mask, a), _mm_andnot_pd(mask, b)); }
+};
+#else
+struct Lanes {
+    typedef double V;
+    static const size_t LANES = 1;
+    static V set(double a) { return a; }
+    static V ramp() { return 0.0; }
+    static V load(const double* p) { return *p; }
+    static void store(double* p, V a) { *p = a; }
+    static V add(V a, V b) { return a + b; }
+    static V sub(V a, V b) { return a - b; }
+    static V mul(V a, V b) { return a * b; }
+    static V max(V a, V b) { return a > b ? a : b; }
+    static V sqrt(V a) { return std::sqrt(a); }
+    static V le(V a, V b) { return a <= b; }
+    static V gt(V a, V b) { return a > b; }
+    static V both(V a, V b) { return a != 0.0 && b != 0.0; }
+    static bool any(V mask) { return mask != 0.0; }
+    static V blend(V mask, V a, V b) { return mask != 0.0 ? a : b; }
+};
+#endif
+
+// y(x) для пачки чисел без ветвлений по отдельным числам: значения всех
+// участков считаются сразу и выбираются масками. Обе полуокружности дают
+// один корень: sqrt(4 - t^2) с t = x + 2 при x <= 0 и t = x при x > 0.
+// Корень - самая дорогая операция, и он пропускается, если в пачке нет
+// точек полуокружностей (на плотной сетке таких пачек две трети).
+inline Lanes::V calculateYLanes(Lanes::V x) {
+    typedef Lanes L;
+    const L::V zero = L::set(0.0), two = L::set(2.0), four = L::set(4.0);
+
+    L::V y = zero;
+    y = L::blend(L::both(L::le(L::set(-7.0), x), L::le(x, L::set(-6.0))), two, y);
+    y = L::blend(L::both(L::gt(x, L::set(-6.0)), L::le(x, L::set(-2.0))),
+                 L::add(L::mul(L::set(0.25), x), L::set(0.5)), y);
+    y = L::blend(L::both(L::gt(x, two), L::le(x, L::set(3.0))), L::sub(two, x), y);
+
+    const L::V onCircle = L::both(L::gt(x, L::set(-2.0)), L::le(x, two));
+    if (L::any(onCircle)) {
+        const L::V left = L::le(x, zero); // нижняя полуокружность
+        const L::V t = L::blend(left, L::add(x, two), x);
+        const L::V root = L::sqrt(L::max(L::sub(four, L::mul(t, t)), zero));
+        y = L::blend(onCircle, L::blend(left, L::sub(two, root), root), y);
+    }
+    return y;
+}
+
+// y[i] = calculateY(x[i]) для n чисел
+void calculateYBulk(const double* x, double* y, size_t n) {
+    size_t i = 0;
+    for (; i + Lanes::LANES <= n; i += Lanes::LANES) {
+        Lanes::store(y + i, calculateYLanes(Lanes::load(x + i)));
+    }
+    for (; i < n; ++i) y[i] = calculateY(x[i]);
+}
+
+// Узел равномерной сетки по номеру: без накопления x += dx ошибка
+// округления не растёт к концу сетки
+inline double gridNode(double xStart, double dx, size_t i) {
+    return xStart + static_cast<double>(i) * dx;
+}
+
+// y[i] = segment(x_i) для узлов с номерами [from, to): по LANES узлов за
+// шаг, хвост - поэлементно
+template<typename Segment>
+void fillSegment(double xStart, double dx, size_t from, size_t to, double* y, Segment segment) {
+    const Lanes::V start = Lanes::set(xStart), step = Lanes::set(dx);
+    const Lanes::V ramp = Lanes::ramp();
+    size_t i = from;
+    for (; i + Lanes::LANES <= to; i += Lanes::LANES) {
+        const Lanes::V index = Lanes::add(Lanes::set(static_cast<double>(i)), ramp);
+        Lanes::store(y + i, segment(Lanes::add(start, Lanes::mul(index, step))));
+    }
+    for (; i < to; ++i) y[i] = calculateY(gridNode(xStart, dx, i));
+}
+
+// Номер первого узла с x > bound (с x >= bound при inclusive). При dx > 0
+// узлы не убывают, поэтому хватает двоичного поиска по номеру, и граница
+// совпадает с выбором участка в calculateY для того же узла.
+size_t firstNodeAbove(double xStart, double dx, size_t count, double bound, bool inclusive) {
+    size_t low = 0, high = count;
+    while (low < high) {
+        const size_t middle = low + (high - low) / 2;
+        const double x = gridNode(xStart, dx, middle);
+        if (inclusive ? x >= bound : x > bound) {
+            high = middle;
+        } else {
+            low = middle + 1;
+        }
+    }
+    return low;
+}
+
+// Таблица на равномерной сетке: y[i] = calculateY(xStart + i * dx).
+// На возрастающей сетке каждый участок графика - отрезок номеров узлов:
+// границы находятся двоичным поиском, и каждый участок заполняется своим
+// циклом без масок (корень считается только на полуокружностях). Для
+// dx <= 0 узлы считаются общей формулой с масками.
+void tabulateY(double xStart, double dx, size_t count, double* y) {
+    typedef Lanes L;
+    if (!(dx > 0.0) || !isfinite(xStart) || !isfinite(gridNode(xStart, dx, count))) {
+        fillSegment(xStart, dx, 0, count, y, calculateYLanes);
+        return;
+    }
+    const L::V zero = L::set(0.0), two = L::set(2.0), four = L::set(4.0);
+
+    const size_t a0 = firstNodeAbove(xStart, dx, count, -7.0, true);
+    const size_t a1 = firstNodeAbove(xStart, dx, count, -6.0, false);
+    const size_t a2 = firstNodeAbove(xStart, dx, count, -2.0, false);
+    const size_t a3 = firstNodeAbove(xStart, dx, count, 0.0, false);
+    const size_t a4 = firstNodeAbove(xStart, dx, count, 2.0, false);
+    const size_t a5 = firstNodeAbove(xStart, dx, count, 3.0, false);
+
+    fillSegment(xStart, dx, 0, a0, y, [&](L::V) { return zero; });
+    fillSegment(xStart, dx, a0, a1, y, [&](L::V) { return two; });
+    fillSegment(xStart, dx, a1, a2, y, [&](L::V x) { return L::add(L::mul(L::set(0.25), x), L::set(0.5)); });
+    fillSegment(xStart, dx, a2, a3, y, [&](L::V x) {
+        const L::V t = L::add(x, two);
+        return L::sub(two, L::sqrt(L::max(L::sub(four, L::mul(t, t)), zero)));
+    });
+    fillSegment(xStart, dx, a3, a4, y, [&](L::V x) { return L::sqrt(L::max(L::sub(four, L::mul(x, x)), zero)); });
+    fillSegment(xStart, dx, a4, a5, y, [&](L::V x) { return L::sub(two, x); });
+    fillSegment(xStart, dx, a5, count, y, [&](L::V) { return zero; });
+}
+
+// Сравнение скорости поэлементного и пакетного вычисления на сетке из
+// count узлов на [-8, 4] (захватывает и точки вне графика)
+void runBenchmark(size_t count) {
+    const double xStart = -8.0, dx = 12.0 / static_cast<double>(count);
+    vector<double> x(count), scalar(count), bulk(count), grid(count);
+    for (size_t i = 0; i < count; ++i) x[i] = gridNode(xStart, dx, i);
+
+    // Лучшее из нескольких повторов: первый проход ещё и заполняет кэш
+    double scalarTime = 1e9, bulkTime = 1e9, gridTime = 1e9;
+    for (int round = 0; round < 5; ++round) {
+        auto start = chrono::steady_clock::now();
+        for (size_t i = 0; i < count; ++i) scalar[i] = calculateY(x[i]);
+        scalarTime = min(scalarTime, chrono::duration<double>(chrono::steady_clock::now() - start).count());
+
+        start = chrono::steady_clock::now();
+        calculateYBulk(x.data(), bulk.data(), count);
+        bulkTime = min(bulkTime, chrono::duration<double>(chrono::steady_clock::now() - start).count());
+
+        start = chrono::steady_clock::now();
+        tabulateY(xStart, dx, count, grid.data());
+        gridTime = min(gridTime, chrono::duration<double>(chrono::steady_clock::now() - start).count());
+    }
+
+    size_t mismatches = 0;
+    for (size_t i = 0; i < count; ++i) mismatches += (scalar[i] != bulk[i]) + (scalar[i] != grid[i]);
+
+    cout << "Узлов: " << count << ", ширина SIMD: " << Lanes::LANES << "\n";
+    cout << fixed << setprecision(2)
+         << "calculateY:     " << count / scalarTime / 1e6 << " млн/с\n"
+         << "calculateYBulk: " << count / bulkTime / 1e6 << " млн/с (x" << scalarTime / bulkTime << ")\n"
+         << "tabulateY:      " << count / gridTime / 1e6 << " млн/с (x" << scalarTime / gridTime << ")\n";
+    cout << "Расхождений: " << mismatches << "\n";
+}
+
+// Гладкий участок графика: y = f(x) на [a, b]
+struct CurvePiece {
+    double a, b;
+    double (*f)(double);
+};
+
+double pieceConstant(double) { return 2.0; }
+double pieceLine(double x) { return 0.25 * x + 0.5; }
+// 4 - (x + 2)^2 = -x (x + 4) и 4 - x^2 = (2 - x)(2 + x): без вычитания
+// близких чисел у концов дуг, где таблица мельчит сильнее всего
+double pieceLowerArc(double x) { return 2.0 - sqrt(max(-x * (x + 4.0), 0.0)); }
+double pieceUpperArc(double x) { return sqrt(max((2.0 - x) * (2.0 + x), 0.0)); }
+double pieceFall(double x) { return -x + 2.0; }
+
+// Участки calculateY слева направо; график рвётся в -7, -6 и 3, на
+// остальных стыках непрерывен
+const CurvePiece CURVE_PIECES[] = {
+    {-7.0, -6.0, pieceConstant},
+    {-6.0, -2.0, pieceLine},
+    {-2.0, 0.0, pieceLowerArc},
+    {0.0, 2.0, pieceUpperArc},
+    {2.0, 3.0, pieceFall},
+};
+
+// Наибольшее отклонение f от хорды на [u, v]. Каждый участок выпуклый или
+// вогнутый, поэтому |f - хорда| на отрезке унимодальна и её максимум
+// находится методом золотого сечения.
+double chordError(double (*f)(double), double u, double v) {
+    const double fu = f(u), slope = (f(v) - fu) / (v - u);
+    auto deviation = [&](double x) { return fabs(f(x) - (fu + slope * (x - u))); };
+    const double ratio = (sqrt(5.0) - 1.0) / 2.0;
+    double lo = u, hi = v;
+    double x1 = hi - ratio * (hi - lo), x2 = lo + ratio * (hi - lo);
+    double d1 = deviation(x1), d2 = deviation(x2);
+    for (int i = 0; i < 80 && hi - lo > 1e-15 * (1.0 + fabs(lo)); ++i) {
+        if (d1 < d2) {
+            lo = x1; x1 = x2; d1 = d2;
+            x2 = lo + ratio * (hi - lo); d2 = deviation(x2);
+        } else {
+            hi = x2; x2 = x1; d2 = d1;
+            x1 = hi - ratio * (hi - lo); d1 = deviation(x1);
+        }
+    }
+    return max(d1, d2);
+}
+
+// Таблица кусочно-линейной интерполяции с неравномерными узлами.
+// Узлы идут по неубыванию x; разрыв - два узла с одним x (значения слева
+// и справа). Отрезок между узлами k и k + 1 полуоткрыт слева, (x_k, x_k+1],
+// как и участки calculateY. Для поиска отрезка за O(1) [xMin, xMax]
+// делится на равные корзины, и для каждой хранится последний узел левее
+// её начала.
+class CurveTable {
+public:
+    // Узлы до погрешности tolerance: отрезок делится пополам, пока
+    // хорда отходит от участка дальше tolerance. Прямые участки дают по
+    // одному отрезку, мелкие шаги остаются только на дугах.
+    explicit CurveTable(double tolerance) {
+        for (const CurvePiece& piece : CURVE_PIECES) {
+            const double ya = piece.f(piece.a);
+            if (xs.empty() || xs.back() != piece.a || ys.back() != ya) addNode(piece.a, ya);
+            refine(piece.f, piece.a, piece.b, tolerance);
+        }
+        xMin = xs.front();
+        xMax = xs.back();
+
+        // Корзин вчетверо больше, чем отрезков: в среднем меньше одного
+        // узла на корзину
+        const size_t count = 4 * xs.size();
+        bucketScale = static_cast<double>(count) / (xMax - xMin);
+        buckets.resize(count);
+        size_t k = 0;
+        for (size_t b = 0; b < count; ++b) {
+            const double start = xMin + static_cast<double>(b) / bucketScale;
+            while (k + 2 < xs.size() && xs[k + 1] < start) ++k;
+            buckets[b] = static_cast<uint32_t>(k);
+        }
+    }
+
+    double operator()(double x) const {
+        if (!(x >= xMin && x <= xMax)) return 0.0;
+        if (x == xMin) return ys.front();
+        size_t b = static_cast<size_t>((x - xMin) * bucketScale);
+        if (b >= buckets.size()) b = buckets.size() - 1;
+
+        // Отрезок (x_k, x_k+1], содержащий x, лежит между узлами корзины b
+        // и следующей: xs[lo] < x <= xs[hi]. Почти во всех корзинах это
+        // соседние узлы; у концов дуг узлы гуще, и там - двоичный поиск.
+        size_t lo = buckets[b];
+        size_t hi = b + 1 < buckets.size() ? buckets[b + 1] + 1 : xs.size() - 1;
+        if (xs[lo] >= x) lo = 0;             // округление при выборе корзины
+        if (xs[hi] < x) hi = xs.size() - 1;
+        while (hi - lo > 1) {
+            const size_t middle = lo + (hi - lo) / 2;
+            if (xs[middle] < x) {
+                lo = middle;
+            } else {
+                hi = middle;
+            }
+        }
+        const double t = (x - xs[lo]) / (xs[hi] - xs[lo]);
+        return ys[lo] + t * (ys[hi] - ys[lo]);
+    }
+
+    size_t size() const { return xs.size(); }
+    double node(size_t k) const { return xs[k]; }
+    double value(size_t k) const { return ys[k]; }
+
+    // Кратчайший отрезок ненулевой длины: такой шаг нужен равномерной
+    // сетке, чтобы везде достичь той же точности
+    double minStep() const {
+        double step = xMax - xMin;
+        for (size_t k = 0; k + 1 < xs.size(); ++k) {
+            if (xs[k + 1] > xs[k]) step = min(step, xs[k + 1] - xs[k]);
+        }
+        return step;
+    }
+
+private:
+    void addNode(double x, double y) {
+        xs.push_back(x);
+        ys.push_back(y);
+    }
+
+    // Добавляет узлы (u, v], считая, что узел u уже есть
+    void refine(double (*f)(double), double u, double v, double tolerance) {
+        // Отрезки короче 1e-15 относительно x не делятся: дальше ошибка
+        // определяется округлением самого f
+        const double middle = u + (v - u) / 2;
+        if (v - u > 1e-15 * (1.0 + fabs(u)) && chordError(f, u, v) > tolerance) {
+            refine(f, u, middle, tolerance);
+            refine(f, middle, v, tolerance);
+        } else {
+            addNode(v, f(v));
+        }
+    }
+
+    vector<double> xs, ys;
+    double xMin, xMax, bucketScale;
+    vector<uint32_t> buckets;
+};
+
+// Таблица до погрешности tolerance: размер, проверка погрешности на
+// плотной сетке, скорость интерполяции; узлы - в файл tablePath (csv)
+int runAdaptive(double tolerance, const string& tablePath) {
+    auto start = chrono::steady_clock::now();
+    const CurveTable table(tolerance);
+    const double buildTime = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    // Проверка на 10^7 узлах равномерной сетки (эталон - tabulateY), все
+    // точки в счёт: разрывы таблица хранит парами узлов с одним x и
+    // отрезками (x_k, x_k+1], так что и у скачков сторона та же, что у calculateY
+    const size_t checks = 10000000;
+    const double xStart = -7.5, dx = 11.0 / static_cast<double>(checks);
+    vector<double> exact(checks), approx(checks);
+    tabulateY(xStart, dx, checks, exact.data());
+    start = chrono::steady_clock::now();
+    for (size_t i = 0; i < checks; ++i) approx[i] = table(gridNode(xStart, dx, i));
+    const double evalTime = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    double maxError = 0;
+    for (size_t i = 0; i < checks; ++i) maxError = max(maxError, fabs(exact[i] - approx[i]));
+
+    const double uniformNodes = (3.0 - (-7.0)) / table.minStep() + 1;
+    cout << "Погрешность: " << tolerance << ", узлов: " << table.size()
+         << " (построено за " << fixed << setprecision(3) << buildTime * 1000 << " мс)\n";
+    cout << defaultfloat << setprecision(6)
+         << "Наибольшая ошибка на " << checks << " точках: " << maxError << "\n"
+         << "Равномерной сетке с той же точностью нужно ~" << uniformNodes << " узлов (x"
+         << uniformNodes / table.size() << ")\n"
+         << "Интерполяция: " << evalTime / checks * 1e9 << " нс на точку\n";
+
+    if (!tablePath.empty()) {
+        FILE* out = fopen(tablePath.c_str(), "w");
+        if (!out) {
+            cerr << "Не удалось записать " << tablePath << "\n";
+            return 1;
+        }
+        fprintf(out, "x,y\n");
+        for (size_t k = 0; k < table.size(); ++k) fprintf(out, "%.17g,%.17g\n", table.node(k), table.value(k));
+        fclose(out);
+    }
+    return maxError <= tolerance * (1 + 1e-9) ? 0 : 1;
+}
+
+int main(int argc, char* argv[]) {
+    size_t benchNodes = 0;   // --bench N: замер на сетке из N узлов вместо вывода таблицы
+    double tolerance = 0;    // --adaptive TOL: неравномерная таблица с ошибкой не больше TOL
+    string tablePath;        // --table FILE: узлы неравномерной таблицы в csv
+
+    for (int i = 1; i < argc; ++i) {
+        string arg = argv[i];
+        if (arg == "--bench" && i + 1 < argc) {
+            benchNodes = strtoull(argv[++i], nullptr, 10);
+        } else if (arg == "--adaptive" && i + 1 < argc) {
+            tolerance = strtod(argv[++i], nullptr);
+        } else if (arg == "--table" && i + 1 < argc) {
+            tablePath = argv[++i];
+        }
+    }
+
+    if (benchNodes > 0) {
+        runBenchmark(benchNodes);
+        return 0;
+    }
+    if (tolerance > 0) {
+        return runAdaptive(tolerance, tablePath);
+    }
+
     const double x_start = -7.0;
     const double x_end = 3.0;
     const double dx = 0.5;
+    const size_t count = static_cast<size_t>(llround((x_end - x_start) / dx)) + 1;
+
+    vector<double> y(count);
+    tabulateY(x_start, dx, count, y.data());
 
     // Заголовок таблицы
     cout << "Таблица значений функции:\n";
@@ -45,10 +468,10 @@ int main() {
     cout << "--------------------------\n";
 
     // Вывод значений функции
-    for (double x = x_start; x <= x_end + 0.001; x += dx) {
-        double y = calculateY(x);
+    for (size_t i = 0; i < count; ++i) {
+        double x = gridNode(x_start, dx, i);
         cout << "| " << setw(5) << x << " | "
-             << fixed << setprecision(2) << setw(8) << y << " |\n";
+             << fixed << setprecision(2) << setw(8) << y[i] << " |\n";
     }
 
     cout << "--------------------------\n";
@@ -1,67 +1,359 @@
 #include <iostream>
+#include <algorithm>
+#include <atomic>
+#include <cfloat>
+#include <climits>
 #include <cmath>
-#include <numeric> // Для std::gcd (наибольший общий делитель)
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
 using namespace std;
 
+// Натуральное число произвольной длины: 32-битные слова, младшее первым
+struct BigNat {
+    vector<uint32_t> limbs; // пусто - ноль
+
+    BigNat(uint32_t value = 0) {
+        if (value) limbs.push_back(value);
+    }
+
+    bool isZero() const { return limbs.empty(); }
+
+    // *this = *this * m + add
+    void mulAdd(uint32_t m, uint32_t add = 0) {
+        uint64_t carry = add;
+        for (uint32_t& limb : limbs) {
+            carry += static_cast<uint64_t>(limb) * m;
+            limb = static_cast<uint32_t>(carry);
+            carry >>= 32;
+        }
+        if (carry) limbs.push_back(static_cast<uint32_t>(carry));
+        trim();
+    }
+
+    // *this += other
+    void add(const BigNat& other) {
+        if (limbs.size() < other.limbs.size()) limbs.resize(other.limbs.size(), 0);
+        uint64_t carry = 0;
+        for (size_t i = 0; i < limbs.size(); ++i) {
+            carry += limbs[i];
+            if (i < other.limbs.size()) carry += other.limbs[i];
+            limbs[i] = static_cast<uint32_t>(carry);
+            carry >>= 32;
+        }
+        if (carry) limbs.push_back(static_cast<uint32_t>(carry));
+    }
+
+    // *this = *this * m + other за один проход (шаг схемы Горнера)
+    void mulAdd(uint32_t m, const BigNat& other) {
+        if (limbs.size() < other.limbs.size()) limbs.resize(other.limbs.size(), 0);
+        uint64_t carry = 0;
+        for (size_t i = 0; i < limbs.size(); ++i) {
+            // limb * m + other + carry < 2^64
+            carry += static_cast<uint64_t>(limbs[i]) * m;
+            if (i < other.limbs.size()) carry += other.limbs[i];
+            limbs[i] = static_cast<uint32_t>(carry);
+            carry >>= 32;
+        }
+        if (carry) limbs.push_back(static_cast<uint32_t>(carry));
+        trim();
+    }
+
+    // *this /= d, возвращает остаток
+    uint32_t divSmall(uint32_t d) {
+        uint64_t rest = 0;
+        for (size_t i = limbs.size(); i-- > 0;) {
+            rest = (rest << 32) | limbs[i];
+            limbs[i] = static_cast<uint32_t>(rest / d);
+            rest %= d;
+        }
+        trim();
+        return static_cast<uint32_t>(rest);
+    }
+
+    // То же для делителя-константы: компилятор заменяет деление умножением
+    template <uint32_t D>
+    uint32_t divConst() {
+        uint64_t rest = 0;
+        for (size_t i = limbs.size(); i-- > 0;) {
+            rest = (rest << 32) | limbs[i];
+            limbs[i] = static_cast<uint32_t>(rest / D);
+            rest %= D;
+        }
+        trim();
+        return static_cast<uint32_t>(rest);
+    }
+
+    // Остаток от деления на d без изменения числа
+    uint32_t modSmall(uint32_t d) const {
+        uint64_t rest = 0;
+        for (size_t i = limbs.size(); i-- > 0;) rest = ((rest << 32) | limbs[i]) % d;
+        return static_cast<uint32_t>(rest);
+    }
+
+    // Десятичная запись: отщепляем по 9 цифр
+    string toString() const {
+        if (isZero()) return "0";
+        BigNat rest = *this;
+        vector<uint32_t> chunks;
+        while (!rest.isZero()) chunks.push_back(rest.divConst<1000000000>());
+        string text = to_string(chunks.back());
+        for (size_t i = chunks.size() - 1; i-- > 0;) {
+            string chunk = to_string(chunks[i]);
+            text += string(9 - chunk.size(), '0') + chunk;
+        }
+        return text;
+    }
+
+private:
+    void trim() {
+        while (!limbs.empty() && limbs.back() == 0) limbs.pop_back();
+    }
+};
+
+// Наибольшая степень a: строка a чисел Эйлера занимает около
+// a^2 log2(a) бит, а строится за O(a^3 log a) операций со словами
+const int MAX_EXPONENT = 2000;
+
+// Строка n чисел Эйлера по строке n - 1:
+//   E(n, k) = (k + 1) E(n - 1, k) + (n - k) E(n - 1, k - 1)
+vector<BigNat> nextEulerianRow(const vector<BigNat>& previous, int n) {
+    vector<BigNat> row(n);
+    for (int k = 0; k < n; ++k) {
+        if (k < static_cast<int>(previous.size())) {
+            row[k] = previous[k];
+            row[k].mulAdd(k + 1);
+        }
+        if (k > 0) {
+            BigNat left = previous[k - 1];
+            left.mulAdd(n - k);
+            row[k].add(left);
+        }
+    }
+    return row;
+}
+
+// Строка a чисел Эйлера E(a, k), k = 0..max(a - 1, 0): число перестановок
+// из a элементов с k подъёмами. Хранятся только запрошенные строки и
+// последняя построенная: из неё растут следующие, а для меньшего
+// незапрошенного a счёт начинается заново. Вызовы с новым a не
+// потокобезопасны; пакетный режим строит все строки заранее.
+const vector<BigNat>& eulerianRow(int a) {
+    static map<int, vector<BigNat>> requested;
+    static vector<BigNat> frontier = {BigNat(1)}; // строка frontierRow
+    static int frontierRow = 0;
+
+    auto known = requested.find(a);
+    if (known != requested.end()) return known->second;
+
+    if (a < frontierRow) {
+        frontier = {BigNat(1)}; // E(0, 0) = 1
+        frontierRow = 0;
+    }
+    while (frontierRow < a) frontier = nextEulerianRow(frontier, ++frontierRow);
+    return requested[a] = frontier;
+}
+
+// Простые делители m с кратностями (пробное деление; m < 2^32)
+vector<pair<uint32_t, int>> factorize(uint32_t m) {
+    vector<pair<uint32_t, int>> factors;
+    for (uint32_t p = 2; static_cast<uint64_t>(p) * p <= m; p += (p == 2 ? 1 : 2)) {
+        int e = 0;
+        while (m % p == 0) {
+            m /= p;
+            ++e;
+        }
+        if (e) factors.push_back({p, e});
+    }
+    if (m > 1) factors.push_back({m, 1});
+    return factors;
+}
+
 // Функция определяет, будет ли ряд иметь конечную сумму
 bool hasFiniteSum(int base) {
     // Сумма будет конечной, если основание степени больше 1
     return base > 1;
 }
 
-// Функция приближённо вычисляет сумму ряда и возвращает её в виде несократимой дроби
-pair<int, int> approximateAsFraction(int exponent, int base) {
-    const double precision = 1e-10;       // Минимальный вклад элемента в сумму
-    const int scale = 1000000;            // Масштаб для преобразования в целые числа
+// Точная сумма ряда sum n^a / b^n (n >= 1, a >= 0, b >= 2) несократимой
+// дробью. Из sum n^a x^n = sum_k E(a, k) x^(k+1) / (1 - x)^(a+1) при x = 1/b:
+//   S = sum_k E(a, k) b^(a-k) / (b - 1)^(a+1)   (= b A_a(b) / (b - 1)^(a+1))
+// Числитель считается по схеме Горнера, а сокращать можно только на
+// простые делители b - 1: на них числитель и делится, пока делится.
+pair<string, string> exactSum(int exponent, int base) {
+    const vector<BigNat>& eulerian = eulerianRow(exponent);
+    BigNat numerator;
+    for (const BigNat& e : eulerian) numerator.mulAdd(base, e);
+    if (exponent > 0) numerator.mulAdd(base); // степени b^(a-k) идут от b^a до b^1
 
-    double total = 0.0;
-    for (int n = 1; ; ++n) {
-        double currentTerm = pow(n, exponent) / pow(base, n); // Текущий член ряда
-        if (currentTerm < precision) break;                   // Прекращаем, если мал
-        total += currentTerm;                                 // Прибавляем к общей сумме
+    BigNat denominator(1);
+    for (auto [p, e] : factorize(static_cast<uint32_t>(base - 1))) {
+        int power = e * (exponent + 1); // степень p в (b - 1)^(a+1)
+        while (power > 0) {
+            // Один остаток по модулю p^k (наибольшей степени в 32 битах)
+            // показывает, сколько множителей p снять за раз
+            uint32_t chunk = 1;
+            int k = 0;
+            while (k < power && static_cast<uint64_t>(chunk) * p <= UINT32_MAX) {
+                chunk *= p;
+                ++k;
+            }
+            uint32_t rest = numerator.modSmall(chunk);
+            uint32_t divisor = 1;
+            int taken = 0;
+            if (rest == 0) {
+                divisor = chunk;
+                taken = k;
+            } else {
+                for (; rest % p == 0; rest /= p, ++taken) divisor *= p;
+            }
+            if (taken == 0) break;
+            numerator.divSmall(divisor);
+            power -= taken;
+            if (taken < k) break;
+        }
+        for (int i = 0; i < power; ++i) denominator.mulAdd(p);
     }
+    return {numerator.toString(), denominator.toString()};
+}
 
-    // Преобразуем сумму в дробь с помощью масштабирования
-    int numerator = static_cast<int>(round(total * scale));
-    int commonDivisor = gcd(numerator, scale); // Упрощаем дробь
-    return {numerator / commonDivisor, scale / commonDivisor};
+// Сумма ряда sum x^n / n^s (полилогарифм Li_s(x), 0 < x <= 1/2, s >= 1)
+// в long double: члены убывают быстрее 2^-n, суммируем, пока член
+// заметен на фоне суммы
+double polylog(long long s, double x) {
+    long double sum = 0, power = 1;
+    for (long long n = 1;; ++n) {
+        power *= x;
+        long double term = power / powl(static_cast<long double>(n), static_cast<long double>(s));
+        sum += term;
+        if (term <= sum * LDBL_EPSILON) break;
+    }
+    return static_cast<double>(sum);
 }
 
-int main() {
-    int a, b;
-    cout << "Введите значение степени a: ";
-    cin >> a;
-    cout << "Введите значение основания b: ";
-    cin >> b;
+// Ответ для одной пары (a, b): "infinity", "irrational", "num/denom",
+// "approx <значение>" или "error <причина>" для a и b вне допустимых границ
+string seriesAnswer(long long a, long long b) {
+    if (a < INT_MIN || a > INT_MAX || b < INT_MIN || b > INT_MAX) return "error a и b должны помещаться в int";
 
-    // Если b равно 1 — каждый член ряда равен 1, 2, 3... → сумма бесконечна
-    if (b == 1) {
-        cout << "infinity" << endl;
-        return 0;
+    // Если b равно 1 — каждый член ряда равен 1, 2, 3... → сумма бесконечна,
+    // и так же при любом основании, не обеспечивающем сходимости
+    if (b == 1 || !hasFiniteSum(b)) return "infinity";
+
+    // При a < 0 сумма - полилогарифм Li_(-a)(1/b). При a = -1 это
+    // ln(b / (b - 1)) - логарифм рационального числа, не равного 1, он
+    // иррационален. Для a <= -2 иррациональность в общем случае не
+    // доказана, поэтому выводится только значение
+    if (a == -1) return "irrational";
+    if (a < 0) {
+        char text[32];
+        snprintf(text, sizeof text, "approx %.17g", polylog(-a, 1.0 / static_cast<double>(b)));
+        return text;
     }
 
-    // Если основание b не обеспечивает сходимости — тоже бесконечная сумма
-    if (!hasFiniteSum(b)) {
-        cout << "infinity" << endl;
-        return 0;
+    if (a > MAX_EXPONENT) return "error a больше " + to_string(MAX_EXPONENT);
+
+    // При a >= 0 сумма всегда рациональна
+    auto [num, denom] = exactSum(static_cast<int>(a), static_cast<int>(b));
+    return num + "/" + denom;
+}
+
+// Пакетный режим: пары "a b" читаются из stdin до конца потока, ответы
+// выводятся по строке на пару в том же порядке. Запросы группируются по a:
+// нужные строки чисел Эйлера строятся один раз, по возрастанию a, до
+// запуска потоков, после чего кэш только читается, а группы разбирают потоки.
+// Внутри группы меняется лишь b в схеме Горнера.
+void runBatch(unsigned threads) {
+    // Весь ввод сразу: разбор strtol быстрее форматированного cin
+    string input;
+    char chunk[1 << 16];
+    size_t got;
+    while ((got = fread(chunk, 1, sizeof chunk, stdin)) > 0) input.append(chunk, got);
+
+    vector<pair<long long, long long>> queries;
+    const char* cursor = input.c_str();
+    for (;;) {
+        char* end;
+        long long a = strtoll(cursor, &end, 10);
+        if (end == cursor) break;
+        cursor = end;
+        long long b = strtoll(cursor, &end, 10);
+        if (end == cursor) break;
+        cursor = end;
+        queries.push_back({a, b}); // границы проверяет seriesAnswer
     }
 
-    // Получаем дробное приближение суммы
-    auto [num, denom] = approximateAsFraction(a, b);
+    // Группы по a; пары без точной суммы отвечаются сразу
+    vector<string> answers(queries.size());
+    map<int, vector<size_t>> byExponent;
+    for (size_t i = 0; i < queries.size(); ++i) {
+        auto [a, b] = queries[i];
+        if (a >= 0 && a <= MAX_EXPONENT && b > 1 && b <= INT_MAX) {
+            byExponent[static_cast<int>(a)].push_back(i);
+        } else {
+            answers[i] = seriesAnswer(a, b);
+        }
+    }
+    for (const auto& group : byExponent) eulerianRow(group.first);
+
+    // Сначала большие a: их группы самые долгие
+    vector<const vector<size_t>*> groups;
+    for (auto it = byExponent.rbegin(); it != byExponent.rend(); ++it) groups.push_back(&it->second);
+
+    atomic<size_t> nextGroup{0};
+    auto worker = [&]() {
+        for (size_t g; (g = nextGroup.fetch_add(1)) < groups.size();) {
+            for (size_t i : *groups[g]) answers[i] = seriesAnswer(queries[i].first, queries[i].second);
+        }
+    };
+    threads = max(1u, min<unsigned>(threads, static_cast<unsigned>(groups.size())));
+    vector<thread> pool;
+    for (unsigned t = 1; t < threads; ++t) pool.emplace_back(worker);
+    worker();
+    for (thread& t : pool) t.join();
+
+    // Вывод одним буфером вместо построчного endl
+    string output;
+    for (const string& answer : answers) {
+        output += answer;
+        output += '\n';
+        if (output.size() >= (1 << 16)) {
+            fwrite(output.data(), 1, output.size(), stdout);
+            output.clear();
+        }
+    }
+    fwrite(output.data(), 1, output.size(), stdout);
+}
+
+int main(int argc, char* argv[]) {
+    bool batch = false;    // --batch: поток пар "a b" из stdin
+    unsigned threads = 0;  // --threads N: потоки пакетного режима (0 - по числу ядер)
 
-    // Сравниваем с "точной" (условно) суммой из первых 100 членов
-    double approxValue = static_cast<double>(num) / denom;
-    double referenceSum = 0.0;
-    for (int n = 1; n < 100; ++n) {
-        referenceSum += pow(n, a) / pow(b, n);
+    for (int i = 1; i < argc; ++i) {
+        string arg = argv[i];
+        if (arg == "--batch") {
+            batch = true;
+        } else if (arg == "--threads" && i + 1 < argc) {
+            threads = static_cast<unsigned>(strtoul(argv[++i], nullptr, 10));
+        }
     }
 
-    // Если приближение и "точная" сумма сильно различаются — считаем иррациональной
-    if (fabs(approxValue - referenceSum) > 1e-6) {
-        cout << "irrational" << endl;
-    } else {
-        cout << num << "/" << denom << endl;
+    if (batch) {
+        runBatch(threads ? threads : max(1u, thread::hardware_concurrency()));
+        return 0;
     }
 
+    long long a, b;
+    cout << "Введите значение степени a: ";
+    cin >> a;
+    cout << "Введите значение основания b: ";
+    cin >> b;
+
+    cout << seriesAnswer(a, b) << endl;
+
     return 0;
 }
@@ -1,55 +1,429 @@
 #include <iostream>   // Для работы с вводом и выводом
 #include <vector>     // Для использования динамических массивов (векторов)
-#include <climits>    // Для константы LLONG_MIN
+#include <algorithm>  // Для min и max
+#include <atomic>     // Для счётчика задач пакетного режима
+#include <cstdint>    // Для int32_t
+#include <cstdio>     // Для fwrite
+#include <cstdlib>    // Для strtoul
+#include <new>        // Для bad_alloc
+#include <string>     // Для разбора аргументов
+#include <thread>     // Для потоков пакетного режима
 
-using namespace std;
+#include <unistd.h>   // Для read: блоками, без iostream
 
-int main() {
-    int totalNumbers, maxTake; // totalNumbers — количество чисел, maxTake — максимум чисел за ход
+#include "mappedfile.h" // Файл через mmap для потокового режима
 
-    cout << "Введите n и m: ";
-    cin >> totalNumbers >> maxTake; // Считываем значения n и m
+using namespace std;
 
-    vector<int> sequence(totalNumbers); // Массив чисел, из которых выбирают игроки
+// Итог игры: преимущество первого игрока при оптимальной игре обоих и,
+// по запросу, сами ходы (сколько чисел берётся на каждом ходу)
+struct GameSolution {
+    long long advantage = 0;
+    vector<int> moves;
+};
 
-    cout << "Ввод: ";
-    for (int i = 0; i < totalNumbers; ++i) {
-        cin >> sequence[i]; // Вводим каждый элемент массива
+// Оптимальная игра за O(n) времени и O(m) памяти.
+//
+// optimalGain[pos] = max по шагу 1..m от (cumulativeSum[pos] - cumulativeSum[j] - optimalGain[j]),
+// j = pos + step. cumulativeSum[pos] от шага не зависит, поэтому
+//   optimalGain[pos] = cumulativeSum[pos] + max_j value[j],  value[j] = -cumulativeSum[j] - optimalGain[j],
+// а максимум по окну j ∈ [pos + 1, pos + m] даёт монотонная очередь.
+// Числа подаются с конца по одному; в очереди не больше min(n, m) + 1
+// кандидатов, поэтому она хранится кольцом из двух плоских массивов
+// (индексы и значения) ёмкостью в степень двойки. Суммы cumulativeSum и
+// optimalGain целиком не хранятся: value[j] лежит в очереди, а сумма
+// хвоста ведётся на ходу.
+class BackwardSolver {
+public:
+    BackwardSolver(int totalNumbers, int maxTake) : pos(totalNumbers), maxTake(maxTake) {
+        size_t capacity = 1;
+        while (capacity < static_cast<size_t>(min(totalNumbers, maxTake)) + 1) capacity <<= 1;
+        windowIndex.resize(capacity);
+        windowValue.resize(capacity);
+        mask = capacity - 1;
     }
 
-    // Массив для хранения максимальной разницы очков от позиции i до конца
-    vector<long long> optimalGain(totalNumbers + 1, 0);
+    // Следующее число с конца (позиция pos = n - 1, n - 2, ..., 0);
+    // возвращает лучший следующий индекс для этой позиции
+    int push(int number) {
+        --pos;
+
+        // Новый кандидат j = pos + 1; при равных значениях выигрывает
+        // меньший шаг, как и в переборе шагов по возрастанию
+        const long long value = -cumulativeSum - optimalGain;
+        while (tail != head && windowValue[(tail - 1) & mask] <= value) --tail;
+        windowIndex[tail & mask] = pos + 1;
+        windowValue[tail & mask] = value;
+        ++tail;
 
-    // cumulativeSum[i] — сумма всех чисел от позиции i до конца массива
-    vector<long long> cumulativeSum(totalNumbers + 1, 0);
+        // Кандидаты дальше pos + maxTake выходят из окна
+        if (windowIndex[head & mask] > static_cast<long long>(pos) + maxTake) ++head;
 
-    // Заполняем cumulativeSum с конца 
-    for (int i = totalNumbers - 1; i >= 0; --i) {
-        cumulativeSum[i] = cumulativeSum[i + 1] + sequence[i];
+        cumulativeSum += number;
+        optimalGain = cumulativeSum + windowValue[head & mask];
+        return windowIndex[head & mask];
     }
 
-    // Обратный проход: вычисляем лучший возможный счёт для каждого начала позиции
+    // optimalGain для последней поданной позиции
+    long long advantage() const { return optimalGain; }
+
+private:
+    int pos;
+    int maxTake;
+    vector<int32_t> windowIndex;  // кольцо очереди: индексы j
+    vector<long long> windowValue; // и их value[j]
+    size_t mask;
+    size_t head = 0, tail = 0; // очередь - [head, tail), значения убывают от head
+    long long cumulativeSum = 0; // сумма чисел от pos до конца
+    long long optimalGain = 0;   // optimalGain[pos]
+};
+
+// Решение для ряда в памяти; ходы восстанавливаются по лучшим переходам,
+// для них нужен массив из n индексов
+GameSolution solveGame(const vector<int>& sequence, int maxTake, bool withMoves) {
+    const int totalNumbers = static_cast<int>(sequence.size());
+    GameSolution solution;
+    if (totalNumbers == 0 || maxTake < 1) return solution;
+
+    BackwardSolver solver(totalNumbers, maxTake);
+    vector<int32_t> bestNext(withMoves ? totalNumbers : 0);
     for (int pos = totalNumbers - 1; pos >= 0; --pos) {
-        long long bestCurrentMove = LLONG_MIN; // Инициализируем минимумом — будем искать максимум
+        int next = solver.push(sequence[pos]);
+        if (withMoves) bestNext[pos] = next;
+    }
+    solution.advantage = solver.advantage();
+
+    // Ходы: от начала по лучшим переходам до конца ряда
+    if (withMoves) {
+        for (int pos = 0; pos < totalNumbers; pos = bestNext[pos]) {
+            solution.moves.push_back(bestNext[pos] - pos);
+        }
+    }
+    return solution;
+}
+
+// Разбор целых из потока большими блоками через read (без iostream).
+// read не ждёт заполнения буфера, так что работает и с терминалом.
+class NumberReader {
+public:
+    explicit NumberReader(int fd) : fd(fd), buffer(1 << 20) {}
+
+    // false, если чисел больше нет
+    bool next(long long& value) {
+        int c = skipSpaces();
+        if (c < 0) return false;
+        bool negative = c == '-';
+        if (negative) c = get();
+        if (c < '0' || c > '9') return false;
+        value = 0;
+        for (; c >= '0' && c <= '9'; c = get()) value = value * 10 + (c - '0');
+        if (negative) value = -value;
+        return true;
+    }
+
+private:
+    int get() {
+        if (position == filled) {
+            ssize_t got = ::read(fd, buffer.data(), buffer.size());
+            if (got <= 0) return -1;
+            filled = static_cast<size_t>(got);
+            position = 0;
+        }
+        return static_cast<unsigned char>(buffer[position++]);
+    }
+
+    int skipSpaces() {
+        int c;
+        do c = get();
+        while (c == ' ' || c == '\n' || c == '\r' || c == '\t');
+        return c;
+    }
+
+    int fd;
+    vector<char> buffer;
+    size_t position = 0, filled = 0;
+};
+
+// Причина, по которой n и m партии не подходят; пустая строка - подходят.
+// Позиции и шаги хранятся в int, поэтому n и m ограничены INT32_MAX; при
+// непустом ряде нужен m >= 1, иначе ходов нет и ответ не определён.
+string checkGameHeader(long long totalNumbers, long long maxTake) {
+    if (totalNumbers < 0 || totalNumbers > INT32_MAX) return "n вне диапазона 0.." + to_string(INT32_MAX);
+    if (maxTake > INT32_MAX) return "m больше " + to_string(INT32_MAX);
+    if (totalNumbers > 0 && maxTake < 1) return "m должно быть не меньше 1";
+    return "";
+}
+
+bool isSpace(uint8_t c) { return c == ' ' || c == '\n' || c == '\r' || c == '\t'; }
+
+// Следующее число в [cursor, end) слева направо; cursor сдвигается за него
+bool scanForward(const uint8_t*& cursor, const uint8_t* end, long long& value) {
+    while (cursor < end && isSpace(*cursor)) ++cursor;
+    bool negative = cursor < end && *cursor == '-';
+    if (negative) ++cursor;
+    if (cursor == end || *cursor < '0' || *cursor > '9') return false;
+    value = 0;
+    for (; cursor < end && *cursor >= '0' && *cursor <= '9'; ++cursor) value = value * 10 + (*cursor - '0');
+    if (negative) value = -value;
+    return true;
+}
+
+// Предыдущее число в [begin, cursor) справа налево; cursor сдвигается перед ним
+bool scanBackward(const uint8_t* begin, const uint8_t*& cursor, long long& value) {
+    while (cursor > begin && isSpace(cursor[-1])) --cursor;
+    const uint8_t* last = cursor;
+    while (cursor > begin && cursor[-1] >= '0' && cursor[-1] <= '9') --cursor;
+    if (cursor == last) return false;
+    value = 0;
+    for (const uint8_t* digit = cursor; digit < last; ++digit) value = value * 10 + (*digit - '0');
+    if (cursor > begin && cursor[-1] == '-') {
+        --cursor;
+        value = -value;
+    }
+    return true;
+}
+
+// Окно опережающего чтения и возврата страниц при разборе файла с конца
+const uintptr_t FILE_WINDOW = 1 << 20;
+
+// Потоковый режим: файл "n m a1 ... an" читается через mmap, числа
+// разбираются с конца и сразу уходят в решатель. Память - O(m):
+// разобранные страницы отображения возвращаются ядру. Чтение идёт назад,
+// поэтому прямое опережающее чтение ядра (MADV_SEQUENTIAL) выключено, а
+// следующее окно перед курсором запрашивается явно (MADV_WILLNEED).
+// Ходы здесь не восстанавливаются: для них нужны все n переходов.
+bool solveGameFile(const string& path, GameSolution& solution) {
+    MappedFile file(path, false);
+    if (!file.valid()) {
+        struct stat st;
+        if (::stat(path.c_str(), &st) == 0 && st.st_size == 0) {
+            cerr << path << " пуст: ожидались n и m" << endl;
+        } else {
+            cerr << "Не удалось открыть " << path << endl;
+        }
+        return false;
+    }
+    const uint8_t* begin = file.data();
+    const uint8_t* end = begin + file.size();
+
+    long long totalNumbers = 0, maxTake = 0;
+    const uint8_t* header = begin;
+    if (!scanForward(header, end, totalNumbers) || !scanForward(header, end, maxTake)) {
+        cerr << "Ожидались n и m в начале " << path << endl;
+        return false;
+    }
+    string problem = checkGameHeader(totalNumbers, maxTake);
+    if (!problem.empty()) {
+        cerr << path << ": " << problem << endl;
+        return false;
+    }
+    if (totalNumbers == 0 || maxTake < 1) return true;
 
-        // Пробуем взять от 1 до maxTake элементов, если они не выходят за границу
-        for (int step = 1; step <= maxTake && pos + step <= totalNumbers; ++step) {
-            // Вычисляем сумму элементов, которые берёт текущий игрок
-            long long currentSum = cumulativeSum[pos] - cumulativeSum[pos + step];
+    BackwardSolver solver(static_cast<int>(totalNumbers), static_cast<int>(maxTake));
+    const uint8_t* cursor = end;
+    const uintptr_t pageSize = static_cast<uintptr_t>(::sysconf(_SC_PAGESIZE));
+    const uintptr_t base = reinterpret_cast<uintptr_t>(begin); // начало отображения выровнено по странице
+    uintptr_t released = reinterpret_cast<uintptr_t>(end); // страницы с этого адреса уже отданы
 
-            // Разница очков: то, что взял игрок, минус то, что получит соперник
-            long long result = currentSum - optimalGain[pos + step];
+    // Окно FILE_WINDOW перед адресом upTo - подкачать заранее
+    auto prefetchBefore = [&](uintptr_t upTo) {
+        uintptr_t from = upTo > base + FILE_WINDOW ? (upTo - FILE_WINDOW) & ~(pageSize - 1) : base;
+        if (from < upTo) ::madvise(reinterpret_cast<void*>(from), upTo - from, MADV_WILLNEED);
+    };
+    prefetchBefore(released);
+    for (long long i = 0; i < totalNumbers; ++i) {
+        long long number;
+        if (!scanBackward(header, cursor, number)) {
+            cerr << "В " << path << " меньше " << totalNumbers << " чисел" << endl;
+            return false;
+        }
+        solver.push(static_cast<int>(number));
+
+        // Разобранные страницы в конце файла больше не нужны: отдаём их
+        // окнами, чтобы и отображение не копилось в памяти процесса, и
+        // просим следующее окно
+        if (released - reinterpret_cast<uintptr_t>(cursor) >= FILE_WINDOW) {
+            uintptr_t from = (reinterpret_cast<uintptr_t>(cursor) + pageSize - 1) & ~(pageSize - 1);
+            ::madvise(reinterpret_cast<void*>(from), released - from, MADV_DONTNEED);
+            released = from;
+            prefetchBefore(released);
+        }
+    }
+    solution.advantage = solver.advantage();
+    return true;
+}
+
+// Одна партия пакетного режима
+struct GameInstance {
+    int maxTake = 0;
+    vector<int> sequence;
+    string error; // непусто - партия не решается, вместо ответа "error <причина>"
+};
+
+// Пакетный режим: из stdin до конца потока идут партии "n m a1 ... an",
+// на каждую выводится строка "результат преимущество" (с --moves - и ходы).
+// Партии независимы и разбираются потоками по атомарному счётчику.
+// Партия, для ряда которой не хватило памяти, пропускается с ошибкой;
+// после неверных n и m или обрыва ввода границы партий не восстановить,
+// поэтому разбор на ней заканчивается.
+void runBatch(unsigned threads, bool withMoves) {
+    vector<GameInstance> instances;
+    NumberReader reader(STDIN_FILENO);
+    long long totalNumbers = 0, maxTake = 0;
+    while (reader.next(totalNumbers)) {
+        GameInstance instance;
+        if (!reader.next(maxTake)) {
+            instance.error = "нет m";
+        } else {
+            instance.error = checkGameHeader(totalNumbers, maxTake);
+        }
+        if (!instance.error.empty()) {
+            instances.push_back(move(instance));
+            break;
+        }
 
-            // Сохраняем максимум из возможных результатов
-            bestCurrentMove = max(bestCurrentMove, result);
+        // Ряд растёт по мере чтения, а не выделяется сразу на n чисел:
+        // огромное n с коротким вводом не займёт память впустую.
+        // Числа партии с ошибкой читаются вхолостую, чтобы дойти до следующей.
+        instance.maxTake = static_cast<int>(maxTake);
+        long long number = 0, read = 0;
+        for (; read < totalNumbers && reader.next(number); ++read) {
+            if (!instance.error.empty()) continue;
+            try {
+                instance.sequence.push_back(static_cast<int>(number));
+            } catch (const bad_alloc&) {
+                instance.error = "не хватает памяти для n = " + to_string(totalNumbers);
+                vector<int>().swap(instance.sequence);
+            }
         }
+        if (read < totalNumbers) {
+            instance.error = "ввод оборвался: прочитано " + to_string(read) + " из " + to_string(totalNumbers) + " чисел";
+            instance.sequence.clear();
+            instances.push_back(move(instance));
+            break;
+        }
+        instances.push_back(move(instance));
+    }
 
-        // Запоминаем лучший результат для текущей позиции
-        optimalGain[pos] = bestCurrentMove;
+    vector<GameSolution> solutions(instances.size());
+    atomic<size_t> nextInstance{0};
+    auto worker = [&]() {
+        for (size_t i; (i = nextInstance.fetch_add(1)) < instances.size();) {
+            if (!instances[i].error.empty()) continue;
+            solutions[i] = solveGame(instances[i].sequence, instances[i].maxTake, withMoves);
+            vector<int>().swap(instances[i].sequence); // ряд больше не нужен
+        }
+    };
+    threads = max(1u, min<unsigned>(threads, static_cast<unsigned>(instances.size())));
+    vector<thread> pool;
+    for (unsigned t = 1; t < threads; ++t) pool.emplace_back(worker);
+    worker();
+    for (thread& t : pool) t.join();
+
+    // Вывод одним буфером вместо построчного endl
+    string output;
+    for (size_t i = 0; i < solutions.size(); ++i) {
+        const GameSolution& solution = solutions[i];
+        if (!instances[i].error.empty()) {
+            output += "error " + instances[i].error + '\n';
+            continue;
+        }
+        output += solution.advantage > 0 ? '1' : '0';
+        output += ' ';
+        output += to_string(solution.advantage);
+        for (int move : solution.moves) {
+            output += ' ';
+            output += to_string(move);
+        }
+        output += '\n';
+        if (output.size() >= (1 << 16)) {
+            fwrite(output.data(), 1, output.size(), stdout);
+            output.clear();
+        }
+    }
+    fwrite(output.data(), 1, output.size(), stdout);
+}
+
+int main(int argc, char* argv[]) {
+    bool printMoves = false; // --moves: вывести и последовательность ходов
+    bool batch = false;      // --batch: много партий из stdin
+    unsigned threads = 0;    // --threads N: потоки пакетного режима (0 - по числу ядер)
+    string path;             // --file FILE: потоковое решение из файла
+
+    for (int i = 1; i < argc; ++i) {
+        string arg = argv[i];
+        if (arg == "--moves") {
+            printMoves = true;
+        } else if (arg == "--batch") {
+            batch = true;
+        } else if (arg == "--threads" && i + 1 < argc) {
+            threads = static_cast<unsigned>(strtoul(argv[++i], nullptr, 10));
+        } else if (arg == "--file" && i + 1 < argc) {
+            path = argv[++i];
+        }
+    }
+
+    if (batch) {
+        runBatch(threads ? threads : max(1u, thread::hardware_concurrency()), printMoves);
+        return 0;
+    }
+
+    GameSolution solution;
+    if (!path.empty()) {
+        if (printMoves) cerr << "--moves не поддерживается с --file: ходы требуют O(n) памяти" << endl;
+        printMoves = false;
+        if (!solveGameFile(path, solution)) return 1;
+    } else {
+        NumberReader reader(STDIN_FILENO);
+        long long totalNumbers = 0, maxTake = 0; // totalNumbers — количество чисел, maxTake — максимум чисел за ход
+
+        cout << "Введите n и m: " << flush;
+        // Считываем значения n и m
+        if (!reader.next(totalNumbers)) {
+            cerr << "нет n" << endl;
+            return 1;
+        }
+        if (!reader.next(maxTake)) {
+            cerr << "нет m" << endl;
+            return 1;
+        }
+        string problem = checkGameHeader(totalNumbers, maxTake);
+        if (!problem.empty()) {
+            cerr << problem << endl;
+            return 1;
+        }
+
+        vector<int> sequence; // Массив чисел, из которых выбирают игроки
+
+        cout << "Ввод: " << flush;
+        long long number = 0;
+        try {
+            // Ряд растёт по мере ввода, а не выделяется сразу на n чисел
+            for (long long i = 0; i < totalNumbers; ++i) {
+                if (!reader.next(number)) {
+                    cerr << "Ввод оборвался: прочитано " << i << " из " << totalNumbers << " чисел" << endl;
+                    return 1;
+                }
+                sequence.push_back(static_cast<int>(number)); // Вводим каждый элемент массива
+            }
+        } catch (const bad_alloc&) {
+            cerr << "Не хватает памяти для n = " << totalNumbers << endl;
+            return 1;
+        }
+
+        solution = solveGame(sequence, static_cast<int>(maxTake), printMoves);
     }
 
     // Побеждает первый игрок, если его итоговое преимущество положительное
-    cout << "Результат: " << (optimalGain[0] > 0 ? 1 : 0) << endl;
+    cout << "Результат: " << (solution.advantage > 0 ? 1 : 0) << endl;
+
+    if (printMoves) {
+        // Ходы игроков по очереди, начиная с первого
+        cout << "Ходы:";
+        for (int move : solution.moves) cout << ' ' << move;
+        cout << '\n';
+        cout << "Преимущество первого игрока: " << solution.advantage << endl;
+    }
 
     return 0; // Завершаем программу
 }